@@ -40,6 +40,11 @@ set_fileset_property QUARTUS_SYNTH TOP_LEVEL burst_master_4
 set_fileset_property QUARTUS_SYNTH ENABLE_RELATIVE_INCLUDE_PATHS false
 add_fileset_file burst_master_4.v VERILOG PATH ../RTL/burst_master_4.v TOP_LEVEL_FILE
 add_fileset_file simple_fifo.v VERILOG PATH ../RTL/simple_fifo.v
+add_fileset_file simple_dcfifo.v VERILOG PATH ../RTL/simple_dcfifo.v
+add_fileset_file pixel_unpack.v VERILOG PATH ../RTL/pixel_unpack.v
+add_fileset_file pixel_pack.v VERILOG PATH ../RTL/pixel_pack.v
+add_fileset_file pixel_scaler.v VERILOG PATH ../RTL/pixel_scaler.v
+add_fileset_file pixel_tile.v VERILOG PATH ../RTL/pixel_tile.v
 
 
 # 
@@ -80,6 +85,13 @@ set_parameter_property PIPE_LATENCY TYPE INTEGER
 set_parameter_property PIPE_LATENCY UNITS None
 set_parameter_property PIPE_LATENCY ALLOWED_RANGES -2147483648:2147483647
 set_parameter_property PIPE_LATENCY HDL_PARAMETER true
+add_parameter DMA_CLK_MHZ INTEGER 100
+set_parameter_property DMA_CLK_MHZ DEFAULT_VALUE 100
+set_parameter_property DMA_CLK_MHZ DISPLAY_NAME DMA_CLK_MHZ
+set_parameter_property DMA_CLK_MHZ TYPE INTEGER
+set_parameter_property DMA_CLK_MHZ UNITS None
+set_parameter_property DMA_CLK_MHZ ALLOWED_RANGES -2147483648:2147483647
+set_parameter_property DMA_CLK_MHZ HDL_PARAMETER true
 
 
 # 
@@ -116,13 +128,57 @@ set_interface_property reset SVD_ADDRESS_GROUP ""
 add_interface_port reset reset_n reset_n Input 1
 
 
+# 
+# connection point dma_clock
+# 
+add_interface dma_clock clock end
+set_interface_property dma_clock clockRate 0
+set_interface_property dma_clock ENABLED true
+set_interface_property dma_clock EXPORT_OF ""
+set_interface_property dma_clock PORT_NAME_MAP ""
+set_interface_property dma_clock CMSIS_SVD_VARIABLES ""
+set_interface_property dma_clock SVD_ADDRESS_GROUP ""
+
+add_interface_port dma_clock dma_clk clk Input 1
+
+
+# 
+# connection point dma_reset
+# 
+add_interface dma_reset reset end
+set_interface_property dma_reset associatedClock dma_clock
+set_interface_property dma_reset synchronousEdges DEASSERT
+set_interface_property dma_reset ENABLED true
+set_interface_property dma_reset EXPORT_OF ""
+set_interface_property dma_reset PORT_NAME_MAP ""
+set_interface_property dma_reset CMSIS_SVD_VARIABLES ""
+set_interface_property dma_reset SVD_ADDRESS_GROUP ""
+
+add_interface_port dma_reset dma_reset_n reset_n Input 1
+
+
+# 
+# connection point qos
+# 
+add_interface qos conduit end
+set_interface_property qos associatedClock ""
+set_interface_property qos associatedReset ""
+set_interface_property qos ENABLED true
+set_interface_property qos EXPORT_OF ""
+set_interface_property qos PORT_NAME_MAP ""
+set_interface_property qos CMSIS_SVD_VARIABLES ""
+set_interface_property qos SVD_ADDRESS_GROUP ""
+
+add_interface_port qos qos_urgent urgent Input 1
+
+
 # 
 # connection point read_master
 # 
 add_interface read_master avalon start
 set_interface_property read_master addressUnits SYMBOLS
-set_interface_property read_master associatedClock clock
-set_interface_property read_master associatedReset reset
+set_interface_property read_master associatedClock dma_clock
+set_interface_property read_master associatedReset dma_reset
 set_interface_property read_master bitsPerSymbol 8
 set_interface_property read_master burstOnBurstBoundariesOnly false
 set_interface_property read_master burstcountUnits WORDS
@@ -156,8 +212,8 @@ add_interface_port read_master rm_burstcount burstcount Output 9
 # 
 add_interface write_master avalon start
 set_interface_property write_master addressUnits SYMBOLS
-set_interface_property write_master associatedClock clock
-set_interface_property write_master associatedReset reset
+set_interface_property write_master associatedClock dma_clock
+set_interface_property write_master associatedReset dma_reset
 set_interface_property write_master bitsPerSymbol 8
 set_interface_property write_master burstOnBurstBoundariesOnly false
 set_interface_property write_master burstcountUnits WORDS
@@ -183,6 +239,7 @@ add_interface_port write_master wm_waitrequest waitrequest Input 1
 add_interface_port write_master wm_writedata writedata Output 32
 add_interface_port write_master wm_burstcount burstcount Output 9
 add_interface_port write_master wm_address address Output 32
+add_interface_port write_master wm_byteenable byteenable Output 4
 
 
 # 
@@ -213,7 +270,7 @@ set_interface_property cs_slave SVD_ADDRESS_GROUP ""
 
 add_interface_port cs_slave avs_write write Input 1
 add_interface_port cs_slave avs_read read Input 1
-add_interface_port cs_slave avs_address address Input 3
+add_interface_port cs_slave avs_address address Input 6
 add_interface_port cs_slave avs_writedata writedata Input 32
 add_interface_port cs_slave avs_readdata readdata Output 32
 set_interface_assignment cs_slave embeddedsw.configuration.isFlash 0
@@ -221,3 +278,21 @@ set_interface_assignment cs_slave embeddedsw.configuration.isMemoryDevice 0
 set_interface_assignment cs_slave embeddedsw.configuration.isNonVolatileStorage 0
 set_interface_assignment cs_slave embeddedsw.configuration.isPrintableDevice 0
 
+
+
+# 
+# connection point irq
+# 
+add_interface irq interrupt end
+set_interface_property irq associatedAddressablePoint cs_slave
+set_interface_property irq associatedClock clock
+set_interface_property irq associatedReset reset
+set_interface_property irq bridgedReceiverOffset ""
+set_interface_property irq bridgesToReceiver ""
+set_interface_property irq ENABLED true
+set_interface_property irq EXPORT_OF ""
+set_interface_property irq PORT_NAME_MAP ""
+set_interface_property irq CMSIS_SVD_VARIABLES ""
+set_interface_property irq SVD_ADDRESS_GROUP ""
+
+add_interface_port irq irq irq Output 1
@@ -109,13 +109,42 @@ set_interface_property reset SVD_ADDRESS_GROUP ""
 add_interface_port reset reset_n reset_n Input 1
 
 
+# 
+# connection point dma_clock
+# 
+add_interface dma_clock clock end
+set_interface_property dma_clock clockRate 0
+set_interface_property dma_clock ENABLED true
+set_interface_property dma_clock EXPORT_OF ""
+set_interface_property dma_clock PORT_NAME_MAP ""
+set_interface_property dma_clock CMSIS_SVD_VARIABLES ""
+set_interface_property dma_clock SVD_ADDRESS_GROUP ""
+
+add_interface_port dma_clock dma_clk clk Input 1
+
+
+# 
+# connection point dma_reset
+# 
+add_interface dma_reset reset end
+set_interface_property dma_reset associatedClock dma_clock
+set_interface_property dma_reset synchronousEdges DEASSERT
+set_interface_property dma_reset ENABLED true
+set_interface_property dma_reset EXPORT_OF ""
+set_interface_property dma_reset PORT_NAME_MAP ""
+set_interface_property dma_reset CMSIS_SVD_VARIABLES ""
+set_interface_property dma_reset SVD_ADDRESS_GROUP ""
+
+add_interface_port dma_reset dma_reset_n reset_n Input 1
+
+
 # 
 # connection point read_master
 # 
 add_interface read_master avalon start
 set_interface_property read_master addressUnits SYMBOLS
-set_interface_property read_master associatedClock clock
-set_interface_property read_master associatedReset reset
+set_interface_property read_master associatedClock dma_clock
+set_interface_property read_master associatedReset dma_reset
 set_interface_property read_master bitsPerSymbol 8
 set_interface_property read_master burstOnBurstBoundariesOnly false
 set_interface_property read_master burstcountUnits WORDS
@@ -149,8 +178,8 @@ add_interface_port read_master rm_waitrequest waitrequest Input 1
 # 
 add_interface write_master_1 avalon start
 set_interface_property write_master_1 addressUnits SYMBOLS
-set_interface_property write_master_1 associatedClock clock
-set_interface_property write_master_1 associatedReset reset
+set_interface_property write_master_1 associatedClock dma_clock
+set_interface_property write_master_1 associatedReset dma_reset
 set_interface_property write_master_1 bitsPerSymbol 8
 set_interface_property write_master_1 burstOnBurstBoundariesOnly false
 set_interface_property write_master_1 burstcountUnits WORDS
@@ -176,6 +205,7 @@ add_interface_port write_master_1 wm_burstcount burstcount Output 9
 add_interface_port write_master_1 wm_waitrequest waitrequest Input 1
 add_interface_port write_master_1 wm_write write Output 1
 add_interface_port write_master_1 wm_writedata writedata Output 32
+add_interface_port write_master_1 wm_byteenable byteenable Output 4
 
 
 # 
@@ -214,3 +244,21 @@ set_interface_assignment csr_slave embeddedsw.configuration.isMemoryDevice 0
 set_interface_assignment csr_slave embeddedsw.configuration.isNonVolatileStorage 0
 set_interface_assignment csr_slave embeddedsw.configuration.isPrintableDevice 0
 
+
+
+# 
+# connection point irq
+# 
+add_interface irq interrupt end
+set_interface_property irq associatedAddressablePoint csr_slave
+set_interface_property irq associatedClock clock
+set_interface_property irq associatedReset reset
+set_interface_property irq bridgedReceiverOffset ""
+set_interface_property irq bridgesToReceiver ""
+set_interface_property irq ENABLED true
+set_interface_property irq EXPORT_OF ""
+set_interface_property irq PORT_NAME_MAP ""
+set_interface_property irq CMSIS_SVD_VARIABLES ""
+set_interface_property irq SVD_ADDRESS_GROUP ""
+
+add_interface_port irq irq irq Output 1
@@ -0,0 +1,287 @@
+#
+# video_pipeline "video_pipeline" v1.0
+#
+# HDMI scanout: CSR (hdmi_sync_gen), scanout DMA master, dual-clock FIFO.
+# DMA_AXI selects the scanout master when the system is generated, and the
+# elaboration callback gives dma_master the matching interface type:
+#   0: Avalon-MM read master (video_dma_master, 32-bit)
+#   1: AXI3 read master (video_dma_axi_master, 64-bit, read channels only)
+# The other protocol's ports are terminated.
+#
+
+#
+# request TCL package from ACDS 16.1
+#
+package require -exact qsys 16.1
+
+
+#
+# module video_pipeline
+#
+set_module_property DESCRIPTION "HDMI scanout pipeline (CSR, DMA master, FIFO)"
+set_module_property NAME video_pipeline
+set_module_property VERSION 1.0
+set_module_property INTERNAL false
+set_module_property OPAQUE_ADDRESS_MAP true
+set_module_property AUTHOR ""
+set_module_property DISPLAY_NAME video_pipeline
+set_module_property INSTANTIATE_IN_SYSTEM_MODULE true
+set_module_property EDITABLE false
+set_module_property REPORT_TO_TALKBACK false
+set_module_property ALLOW_GREYBOX_GENERATION false
+set_module_property REPORT_HIERARCHY false
+set_module_property ELABORATION_CALLBACK elaborate
+
+
+#
+# file sets
+#
+add_fileset QUARTUS_SYNTH QUARTUS_SYNTH "" ""
+set_fileset_property QUARTUS_SYNTH TOP_LEVEL video_pipeline
+set_fileset_property QUARTUS_SYNTH ENABLE_RELATIVE_INCLUDE_PATHS false
+add_fileset_file video_pipeline.v VERILOG PATH ../RTL/video_pipeline.v TOP_LEVEL_FILE
+add_fileset_file video_dma_master.v VERILOG PATH ../RTL/video_dma_master.v
+add_fileset_file video_dma_axi_master.v VERILOG PATH ../RTL/video_dma_axi_master.v
+add_fileset_file simple_dcfifo.v VERILOG PATH ../RTL/simple_dcfifo.v
+add_fileset_file hdmi_sync_gen.v VERILOG PATH ../RTL/hdmi_sync_gen.v
+
+
+#
+# parameters
+#
+add_parameter DMA_AXI INTEGER 0
+set_parameter_property DMA_AXI DEFAULT_VALUE 0
+set_parameter_property DMA_AXI DISPLAY_NAME "Scanout master"
+set_parameter_property DMA_AXI TYPE INTEGER
+set_parameter_property DMA_AXI UNITS None
+set_parameter_property DMA_AXI ALLOWED_RANGES {"0:Avalon-MM (video_dma_master, 32-bit)" "1:AXI3 (video_dma_axi_master, 64-bit)"}
+set_parameter_property DMA_AXI HDL_PARAMETER true
+add_parameter URGENT_LOW INTEGER 128
+set_parameter_property URGENT_LOW DEFAULT_VALUE 128
+set_parameter_property URGENT_LOW DISPLAY_NAME URGENT_LOW
+set_parameter_property URGENT_LOW TYPE INTEGER
+set_parameter_property URGENT_LOW UNITS None
+set_parameter_property URGENT_LOW ALLOWED_RANGES 0:511
+set_parameter_property URGENT_LOW HDL_PARAMETER true
+add_parameter URGENT_HIGH INTEGER 256
+set_parameter_property URGENT_HIGH DEFAULT_VALUE 256
+set_parameter_property URGENT_HIGH DISPLAY_NAME URGENT_HIGH
+set_parameter_property URGENT_HIGH TYPE INTEGER
+set_parameter_property URGENT_HIGH UNITS None
+set_parameter_property URGENT_HIGH ALLOWED_RANGES 0:512
+set_parameter_property URGENT_HIGH HDL_PARAMETER true
+
+
+#
+# connection point clock (CSR, 50 MHz)
+#
+add_interface clock clock end
+set_interface_property clock clockRate 0
+set_interface_property clock ENABLED true
+set_interface_property clock EXPORT_OF ""
+set_interface_property clock PORT_NAME_MAP ""
+set_interface_property clock CMSIS_SVD_VARIABLES ""
+set_interface_property clock SVD_ADDRESS_GROUP ""
+
+add_interface_port clock clk_50 clk Input 1
+
+
+#
+# connection point reset
+# Asserted asynchronously, released per clock domain inside video_pipeline
+#
+add_interface reset reset end
+set_interface_property reset associatedClock clock
+set_interface_property reset synchronousEdges NONE
+set_interface_property reset ENABLED true
+set_interface_property reset EXPORT_OF ""
+set_interface_property reset PORT_NAME_MAP ""
+set_interface_property reset CMSIS_SVD_VARIABLES ""
+set_interface_property reset SVD_ADDRESS_GROUP ""
+
+add_interface_port reset reset_n reset_n Input 1
+
+
+#
+# connection point dma_clock
+#
+add_interface dma_clock clock end
+set_interface_property dma_clock clockRate 0
+set_interface_property dma_clock ENABLED true
+set_interface_property dma_clock EXPORT_OF ""
+set_interface_property dma_clock PORT_NAME_MAP ""
+set_interface_property dma_clock CMSIS_SVD_VARIABLES ""
+set_interface_property dma_clock SVD_ADDRESS_GROUP ""
+
+add_interface_port dma_clock clk_dma clk Input 1
+
+
+#
+# connection point pixel_clock
+#
+add_interface pixel_clock clock end
+set_interface_property pixel_clock clockRate 0
+set_interface_property pixel_clock ENABLED true
+set_interface_property pixel_clock EXPORT_OF ""
+set_interface_property pixel_clock PORT_NAME_MAP ""
+set_interface_property pixel_clock CMSIS_SVD_VARIABLES ""
+set_interface_property pixel_clock SVD_ADDRESS_GROUP ""
+
+add_interface_port pixel_clock clk_hdmi clk Input 1
+
+
+#
+# connection point csr (hdmi_sync_gen registers 0-7)
+#
+add_interface csr avalon end
+set_interface_property csr addressUnits WORDS
+set_interface_property csr associatedClock clock
+set_interface_property csr associatedReset reset
+set_interface_property csr bitsPerSymbol 8
+set_interface_property csr burstOnBurstBoundariesOnly false
+set_interface_property csr burstcountUnits WORDS
+set_interface_property csr explicitAddressSpan 0
+set_interface_property csr holdTime 0
+set_interface_property csr linewrapBursts false
+set_interface_property csr maximumPendingReadTransactions 1
+set_interface_property csr maximumPendingWriteTransactions 0
+set_interface_property csr readLatency 0
+set_interface_property csr readWaitTime 1
+set_interface_property csr setupTime 0
+set_interface_property csr timingUnits Cycles
+set_interface_property csr writeWaitTime 0
+set_interface_property csr ENABLED true
+set_interface_property csr EXPORT_OF ""
+set_interface_property csr PORT_NAME_MAP ""
+set_interface_property csr CMSIS_SVD_VARIABLES ""
+set_interface_property csr SVD_ADDRESS_GROUP ""
+
+add_interface_port csr s_address address Input 3
+add_interface_port csr s_read read Input 1
+add_interface_port csr s_write write Input 1
+add_interface_port csr s_writedata writedata Input 32
+add_interface_port csr s_readdata readdata Output 32
+add_interface_port csr s_readdatavalid readdatavalid Output 1
+set_interface_assignment csr embeddedsw.configuration.isFlash 0
+set_interface_assignment csr embeddedsw.configuration.isMemoryDevice 0
+set_interface_assignment csr embeddedsw.configuration.isNonVolatileStorage 0
+set_interface_assignment csr embeddedsw.configuration.isPrintableDevice 0
+
+
+#
+# connection point qos (scanout FIFO running low -> burst_master_4)
+#
+add_interface qos conduit start
+set_interface_property qos associatedClock ""
+set_interface_property qos associatedReset ""
+set_interface_property qos ENABLED true
+set_interface_property qos EXPORT_OF ""
+set_interface_property qos PORT_NAME_MAP ""
+set_interface_property qos CMSIS_SVD_VARIABLES ""
+set_interface_property qos SVD_ADDRESS_GROUP ""
+
+add_interface_port qos qos_urgent urgent Output 1
+
+
+#
+# connection point hdmi
+#
+add_interface hdmi conduit end
+set_interface_property hdmi associatedClock ""
+set_interface_property hdmi associatedReset ""
+set_interface_property hdmi ENABLED true
+set_interface_property hdmi EXPORT_OF ""
+set_interface_property hdmi PORT_NAME_MAP ""
+set_interface_property hdmi CMSIS_SVD_VARIABLES ""
+set_interface_property hdmi SVD_ADDRESS_GROUP ""
+
+add_interface_port hdmi hdmi_d d Output 24
+add_interface_port hdmi hdmi_de de Output 1
+add_interface_port hdmi hdmi_hs hs Output 1
+add_interface_port hdmi hdmi_vs vs Output 1
+add_interface_port hdmi debug_leds debug_leds Output 8
+
+
+#
+# connection point dma_master (added in elaborate)
+#
+set avalon_ports {
+    m_waitrequest   waitrequest   Input  1
+    m_readdata      readdata      Input  32
+    m_readdatavalid readdatavalid Input  1
+    m_address       address       Output 32
+    m_read          read          Output 1
+    m_burstcount    burstcount    Output 8
+}
+
+set axi_ports {
+    axm_arid    arid    Output 4
+    axm_araddr  araddr  Output 32
+    axm_arlen   arlen   Output 4
+    axm_arsize  arsize  Output 3
+    axm_arburst arburst Output 2
+    axm_arlock  arlock  Output 2
+    axm_arcache arcache Output 4
+    axm_arprot  arprot  Output 3
+    axm_arvalid arvalid Output 1
+    axm_arready arready Input  1
+    axm_rid     rid     Input  4
+    axm_rdata   rdata   Input  64
+    axm_rresp   rresp   Input  2
+    axm_rlast   rlast   Input  1
+    axm_rvalid  rvalid  Input  1
+    axm_rready  rready  Output 1
+}
+
+proc add_ports {intf ports terminate} {
+    foreach {port role dir width} $ports {
+        add_interface_port $intf $port $role $dir $width
+        if {$terminate} {
+            set_port_property $port TERMINATION true
+        }
+    }
+}
+
+proc elaborate {} {
+    global avalon_ports axi_ports
+
+    if {[get_parameter_value DMA_AXI]} {
+        add_interface dma_master axi start
+        set_interface_property dma_master associatedClock dma_clock
+        set_interface_property dma_master associatedReset reset
+        set_interface_property dma_master readIssuingCapability 8
+        set_interface_property dma_master writeIssuingCapability 1
+        set_interface_property dma_master combinedIssuingCapability 8
+        set_interface_property dma_master ENABLED true
+        add_ports dma_master $axi_ports 0
+
+        add_interface unused_master conduit end
+        set_interface_property unused_master ENABLED false
+        add_ports unused_master $avalon_ports 1
+    } else {
+        add_interface dma_master avalon start
+        set_interface_property dma_master addressUnits SYMBOLS
+        set_interface_property dma_master associatedClock dma_clock
+        set_interface_property dma_master associatedReset reset
+        set_interface_property dma_master bitsPerSymbol 8
+        set_interface_property dma_master burstOnBurstBoundariesOnly false
+        set_interface_property dma_master burstcountUnits WORDS
+        set_interface_property dma_master doStreamReads false
+        set_interface_property dma_master doStreamWrites false
+        set_interface_property dma_master holdTime 0
+        set_interface_property dma_master linewrapBursts false
+        set_interface_property dma_master maximumPendingReadTransactions 4
+        set_interface_property dma_master maximumPendingWriteTransactions 0
+        set_interface_property dma_master readLatency 0
+        set_interface_property dma_master readWaitTime 1
+        set_interface_property dma_master setupTime 0
+        set_interface_property dma_master timingUnits Cycles
+        set_interface_property dma_master writeWaitTime 0
+        set_interface_property dma_master ENABLED true
+        add_ports dma_master $avalon_ports 0
+
+        add_interface unused_master conduit end
+        set_interface_property unused_master ENABLED false
+        add_ports unused_master $axi_ports 1
+    }
+}
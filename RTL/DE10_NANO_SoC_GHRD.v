@@ -100,22 +100,9 @@ module DE10_NANO_SoC_GHRD(
   wire 		  fpga_clk_50;
   
   assign fpga_clk_50 = FPGA_CLK1_50;
-  
-  // Video DMA Interface Wires
-  wire        dma_waitrequest;
-  wire [31:0] dma_readdata;
-  wire        dma_readdatavalid;
-  wire [7:0]  dma_burstcount;
-  wire [31:0] dma_address;
-  wire        dma_read;
 
-  // HDMI Sync Gen Control Interface (Exported from Qsys)
-  wire [2:0]  hsg_s_address;
-  wire        hsg_s_read;
-  wire        hsg_s_write;
-  wire [31:0] hsg_s_writedata;
-  wire [31:0] hsg_s_readdata;
-  wire        hsg_s_readdatavalid;
+  // HDMI Video Pipeline (Qsys video_pipeline_0) debug LEDs
+  wire [7:0]  pipeline_debug;
 
   // HDMI I2C Wires
 
@@ -242,72 +229,24 @@ soc_system u0 (
      .hps_0_f2h_stm_hw_events_stm_hwevents  (stm_hw_events ),  //        hps_0_f2h_stm_hw_events.stm_hwevents
      .hps_0_f2h_warm_reset_req_reset_n      (~hps_warm_reset ),      //       hps_0_f2h_warm_reset_req.reset_n
 
-		// HDMI Video Pipeline
+		// HDMI Video Pipeline (video_pipeline_0, scanout master chosen by its DMA_AXI parameter)
 	  .pll_outclk_clk                        (HDMI_TX_CLK),           //                     pll_outclk.clk
-	  .video_dma_s_waitrequest               (dma_waitrequest),       //                    video_dma_s.waitrequest
-	  .video_dma_s_readdata                  (dma_readdata),          //                               .readdata
-	  .video_dma_s_readdatavalid             (dma_readdatavalid),     //                               .readdatavalid
-	  .video_dma_s_burstcount                ({1'b0, dma_burstcount}),//                               .burstcount
-	  .video_dma_s_writedata                 (32'd0),                 //                               .writedata
-	  .video_dma_s_address                   (dma_address),           //                               .address
-	  .video_dma_s_write                     (1'b0),                  //                               .write
-	  .video_dma_s_read                      (dma_read),              //                               .read
-	  .video_dma_s_byteenable                (4'h0),                  //                               .byteenable
-	  .video_dma_s_debugaccess               (1'b0),                  //                               .debugaccess
+	  .video_hdmi_d                          (HDMI_TX_D),             //                     video_hdmi.d
+	  .video_hdmi_de                         (HDMI_TX_DE),            //                               .de
+	  .video_hdmi_hs                         (HDMI_TX_HS),            //                               .hs
+	  .video_hdmi_vs                         (HDMI_TX_VS),            //                               .vs
+	  .video_hdmi_debug_leds                 (pipeline_debug),        //                               .debug_leds
 
 		// HDMI I2C
 	  .i2c_hdmi_sda_in                       (hdmi_i2c_sda_in),       //                       i2c_hdmi.sda_in
 	  .i2c_hdmi_scl_in                       (hdmi_i2c_scl_in),       //                               .scl_in
 	  .i2c_hdmi_sda_oe                       (hdmi_i2c_sda_oe),       //                               .sda_oe
-	  .i2c_hdmi_scl_oe                       (hdmi_i2c_scl_oe),       //                               .scl_oe
-
-		// HDMI Sync Gen Control (Master Exported)
-	  .hdmi_sync_master_waitrequest          (1'b0),
-	  .hdmi_sync_master_readdata             (hsg_s_readdata),        //                               .readdata
-	  .hdmi_sync_master_readdatavalid        (hsg_s_readdatavalid),   //                               .readdatavalid
-	  .hdmi_sync_master_burstcount           (),                      //                               .burstcount (Not used)
-	  .hdmi_sync_master_writedata            (hsg_s_writedata),       //                               .writedata
-	  .hdmi_sync_master_address              (hsg_s_address),         //                               .address
-	  .hdmi_sync_master_write                (hsg_s_write),           //                               .write
-	  .hdmi_sync_master_read                 (hsg_s_read),            //                               .read
-	  .hdmi_sync_master_byteenable           (),                      //                               .byteenable (Not used)
-	  .hdmi_sync_master_debugaccess          ()                       //                               .debugaccess (Not used)
+	  .i2c_hdmi_scl_oe                       (hdmi_i2c_scl_oe)        //                               .scl_oe
  );
 
-// HDMI Sync & Pattern Generator (Solid Red)
-// HDMI Video Pipeline (Includes DMA Master & Sync Gen)
-video_pipeline u_pipeline (
-    // Clocks & Reset
-    .clk_50            (fpga_clk_50),           // 50 MHz for DMA & CSR
-    .clk_hdmi          (HDMI_TX_CLK),           // ~37.8 MHz for Video
-    .reset_n           (hps_fpga_reset_n),
-
-    // Avalon-MM Master Interface (DMA to DDR3)
-    .m_waitrequest     (dma_waitrequest),
-    .m_readdata        (dma_readdata),
-    .m_readdatavalid   (dma_readdatavalid),
-    .m_address         (dma_address),
-    .m_read            (dma_read),
-    .m_burstcount      (dma_burstcount),
-
-    // Avalon-MM Slave Interface (CSR from Nios II)
-    .s_address         (hsg_s_address),
-    .s_read            (hsg_s_read),
-    .s_write           (hsg_s_write),
-    .s_writedata       (hsg_s_writedata),
-    .s_readdata        (hsg_s_readdata),
-    .s_readdatavalid   (hsg_s_readdatavalid),
-
-    // HDMI Physical Output Signals
-    .hdmi_d            (HDMI_TX_D),
-    .hdmi_de           (HDMI_TX_DE),
-    .hdmi_hs           (HDMI_TX_HS),
-    .hdmi_vs           (HDMI_TX_VS),
-    
-    .debug_leds        (pipeline_debug)
-);
-
-wire [7:0] pipeline_debug;
+// HDMI Video Pipeline (CSR, scanout DMA and FIFO) is the Qsys component video_pipeline_0.
+// Its DMA_AXI parameter picks the scanout master and the dma_master interface type
+// when soc_system is generated (Component/video_pipeline_hw.tcl).
 
 // HDMI I2C Tri-state Buffer
 assign HDMI_I2C_SCL = hdmi_i2c_scl_oe ? 1'b0 : 1'bz;
@@ -40,10 +40,11 @@
  * [제어 인터페이스: Avalon-MM CSR Slave]
  * CPU(Nios II)가 레지스터를 통해 DMA를 제어합니다:
  * - 0x0: Control (Start 명령)
- * - 0x1: Status (Done 확인)
+ * - 0x1: Status (Done 확인, Align Error)
  * - 0x2: Source Address
  * - 0x3: Destination Address
  * - 0x4: Length (Bytes)
+ * - 0x7: IRQ Enable
  * 
  * [동작 시퀀스]
  * 1. CPU가 Source/Dest 주소와 Length를 설정
@@ -52,6 +53,21 @@
  * 4. Write Master: FIFO 데이터 확인 후 메모리에 쓰기 시작
  * 5. 모든 데이터 전송 완료 후 Done 플래그 설정
  * 6. CPU가 Done을 확인하고 다음 작업 진행
+ *    (IRQ Enable이면 Done이 irq를 올리므로 CPU는 Polling 없이 ISR에서 확인)
+ *
+ * [Byte 단위 길이]
+ * LEN은 Byte 단위 그대로 지킵니다. 목적지 범위 밖은 쓰지 않습니다.
+ * - 본문은 설정한 최대 버스트로, 마지막 버스트만 남은 Word 수만큼 짧게 냅니다.
+ * - SRC/DST가 Word 정렬이 아니면 정렬된 주소부터 읽고 쓰며, 첫 Word와 마지막 Word는
+ *   wm_byteenable로 범위 안의 Byte만 씁니다.
+ * - Byte를 옮기는(Shift) 회로는 없으므로 SRC[1:0]과 DST[1:0]이 같아야 합니다.
+ *   다르면 Start를 받지 않고 바로 Done과 STATUS[2] Align Error를 올립니다. (메모리 접근 없음)
+ *
+ * [클럭 도메인]
+ * - clk     : CSR Slave (Nios II, 50MHz)
+ * - dma_clk : Read/Write Master와 FIFO (100~150MHz)
+ * 메모리 버스를 CSR보다 빠른 클럭으로 돌려 인터페이스 폭을 늘리지 않고 대역폭을 높입니다.
+ * Start/Done 신호는 Toggle Synchronizer로 두 도메인을 건너갑니다.
  */
 
 module burst_master #(
@@ -60,8 +76,10 @@ module burst_master #(
     parameter BURST_COUNT = 256,    // Burst당 256 워드 = 1KB
     parameter FIFO_DEPTH = 512      // 512 워드 = 2KB FIFO
 )(
-    input  wire                   clk,
+    input  wire                   clk,            // CSR 클럭 (50MHz)
     input  wire                   reset_n,
+    input  wire                   dma_clk,        // Master/FIFO 클럭 (고속)
+    input  wire                   dma_reset_n,
 
     // =========================================================================
     // Avalon-MM CSR Slave (제어/상태 레지스터)
@@ -73,6 +91,9 @@ module burst_master #(
     input  wire [31:0]            avs_writedata,  // 쓸 데이터
     output reg  [31:0]            avs_readdata,   // 읽은 데이터
 
+    // 완료 인터럽트 (clk 도메인, Level: Done W1C로 내림)
+    output wire                   irq,
+
     // =========================================================================
     // Avalon-MM Read Master (메모리 읽기)
     // =========================================================================
@@ -92,6 +113,7 @@ module burst_master #(
     output reg                    wm_write,         // 쓰기 요청
     output wire [DATA_WIDTH-1:0]  wm_writedata,     // 쓸 데이터
     output reg  [8:0]             wm_burstcount,    // Burst 길이 (가변)
+    output wire [DATA_WIDTH/8-1:0] wm_byteenable,   // 첫/마지막 Word의 유효 Byte
     input  wire                   wm_waitrequest    // Slave 대기 요청
 );
 
@@ -104,13 +126,30 @@ module burst_master #(
     // -----------------------------------------------------------------
     reg                   ctrl_start;       // 전송 시작 명령 (Pulse)
     reg                   ctrl_done_reg;    // 전송 완료 플래그
+    reg                   ctrl_align_err;   // SRC/DST Byte 위치가 달라 Start를 거부함
     reg [ADDR_WIDTH-1:0]  ctrl_src_addr;    // Source 주소
     reg [ADDR_WIDTH-1:0]  ctrl_dst_addr;    // Destination 주소
-    reg [ADDR_WIDTH-1:0]  ctrl_len;         // 전송 길이 (Bytes)
+    reg [ADDR_WIDTH-1:0]  ctrl_len;         // 전송 길이 (Bytes, 정렬/Padding 없음)
     
     // [New] Programmable Burst Counts
     reg [8:0]             ctrl_rd_burst;    // Read Master Burst Count
     reg [8:0]             ctrl_wr_burst;    // Write Master Burst Count
+    reg                   ctrl_busy;        // Start ~ Done 사이 High (clk 도메인)
+    reg                   ctrl_irq_en;      // Done 인터럽트 Enable
+
+    // Done이 남아 있는 동안 High (STATUS에 1을 써서 Done을 지우면 내려감)
+    assign irq = ctrl_done_reg && ctrl_irq_en;
+
+    // dma_clk 도메인 복사본 (dma_start 시점에 래치)
+    reg [8:0]             run_rd_burst;
+    reg [8:0]             run_wr_burst;
+    reg [3:0]             run_be_head;      // 첫 Word Byteenable
+    reg [3:0]             run_be_tail;      // 마지막 Word Byteenable
+
+    // Word 정렬: DST[1:0] 만큼 앞으로 늘리고 4 Byte 단위로 올린 길이
+    wire [1:0]            len_head  = ctrl_dst_addr[1:0];
+    wire [1:0]            len_end   = ctrl_len[1:0] + len_head;    // 마지막 Word의 유효 Byte 수 (0 = 4)
+    wire [ADDR_WIDTH-1:0] len_words = (ctrl_len + len_head + 3) & ~32'd3;
 
     // -----------------------------------------------------------------
     // FIFO 인터페이스 신호
@@ -136,12 +175,62 @@ module burst_master #(
     // -----------------------------------------------------------------
     reg [ADDR_WIDTH-1:0] current_dst_addr;      // 현재 쓰기 주소
     reg [ADDR_WIDTH-1:0] remaining_len;         // 남은 쓰기 길이 (Bytes)
+    reg [ADDR_WIDTH-1:0] len_total;             // 전체 쓰기 길이 (첫 Word 판별용)
 
     // -----------------------------------------------------------------
     // 내부 제어 신호
     // -----------------------------------------------------------------
     reg internal_done_pulse;  // 전송 완료 시 1 클럭 동안 High
 
+    // =========================================================================
+    // CDC (clk <-> dma_clk)
+    // =========================================================================
+    /*
+     * [Start] clk -> dma_clk
+     *   ctrl_start Pulse를 Toggle로 바꾼 뒤 dma_clk에서 3단 동기화 후 Edge 검출.
+     *   Pulse를 그대로 넘기면 빠른 클럭 -> 느린 클럭 방향(Done)에서 놓칠 수 있으므로
+     *   양방향 모두 Toggle 방식을 사용합니다.
+     *
+     * [Done] dma_clk -> clk
+     *   internal_done_pulse -> done_toggle -> clk에서 동기화 -> csr_done_pulse
+     *
+     * [설정 레지스터] SRC/DST/LEN/BURST
+     *   CPU가 Start 전에 설정하고 전송 중에는 바꾸지 않는 정적(Quasi-static) 값입니다.
+     *   Toggle이 동기화되는 동안 이미 안정되어 있으므로 dma_start 시점에 래치해도 안전합니다.
+     */
+    reg       start_toggle;                 // clk 도메인
+    reg [2:0] start_sync;                   // dma_clk 도메인
+    wire      dma_start = start_sync[2] ^ start_sync[1];
+
+    reg       done_toggle;                  // dma_clk 도메인
+    reg [2:0] done_sync;                    // clk 도메인
+    wire      csr_done_pulse = done_sync[2] ^ done_sync[1];
+
+    always @(posedge dma_clk or negedge dma_reset_n) begin
+        if (!dma_reset_n) begin
+            start_sync   <= 3'b0;
+            done_toggle  <= 1'b0;
+            run_rd_burst <= BURST_COUNT;
+            run_wr_burst <= BURST_COUNT;
+            run_be_head  <= 4'hF;
+            run_be_tail  <= 4'hF;
+        end else begin
+            start_sync <= {start_sync[1:0], start_toggle};
+            if (internal_done_pulse) done_toggle <= ~done_toggle;
+            if (dma_start) begin
+                run_rd_burst <= ctrl_rd_burst;
+                run_wr_burst <= ctrl_wr_burst;
+                run_be_head  <= 4'hF << len_head;
+                run_be_tail  <= (len_end == 0) ? 4'hF : 4'hF >> (3'd4 - len_end);
+            end
+        end
+    end
+
+    always @(posedge clk or negedge reset_n) begin
+        if (!reset_n) done_sync <= 3'b0;
+        else          done_sync <= {done_sync[1:0], done_toggle};
+    end
+
     // =========================================================================
     // CSR 로직 (Avalon-MM Slave 동작)
     // =========================================================================
@@ -150,51 +239,64 @@ module burst_master #(
      * 
      * [주소 맵]
      * 0: Control (Start=Bit0)
-     * 1: Status (Done=Bit0, W1C)
+     * 1: Status (Done=Bit0, W1C / Busy=Bit1, RO / Align Error=Bit2, RO, 다음 Start까지 유지)
      * 2: Source Address
      * 3: Destination Address
-     * 4: Length (Bytes, with Padding)
+     * 4: Length (Bytes, 그대로)
      * 5: Read Burst Count (Default: Parameter BURST_COUNT)
      * 6: Write Burst Count (Default: Parameter BURST_COUNT)
+     * 7: IRQ Enable (Bit0), [31] IRQ Pending (RO)
      */
     always @(posedge clk or negedge reset_n) begin
         if (!reset_n) begin
             ctrl_start    <= 0;
             ctrl_done_reg <= 0;
+            ctrl_align_err <= 0;
+            ctrl_busy     <= 0;
+            start_toggle  <= 0;
             ctrl_src_addr <= 0;
             ctrl_dst_addr <= 0;
             ctrl_len      <= 0;
             ctrl_rd_burst <= BURST_COUNT; // Default Reset Value
             ctrl_wr_burst <= BURST_COUNT; // Default Reset Value
+            ctrl_irq_en   <= 0;
         end else begin
             // Start Pulse Auto-Clear: 1 클럭 후 자동으로 0
-            if (ctrl_start) ctrl_start <= 0;
+            // 동시에 Toggle을 뒤집어 dma_clk 도메인으로 전달
+            if (ctrl_start) begin
+                ctrl_start   <= 0;
+                start_toggle <= ~start_toggle;
+                ctrl_busy    <= 1;
+            end
 
-            // Done Flag Set: FSM이 완료 시 Pulse를 보내면 플래그 설정
-            if (internal_done_pulse) begin
+            // Done Flag Set: dma_clk 도메인에서 동기화된 완료 Pulse
+            if (csr_done_pulse) begin
                 ctrl_done_reg <= 1;
+                ctrl_busy     <= 0;
             end
 
             // Avalon-MM Write 처리
             if (avs_write) begin
                 case (avs_address)
                     3'd0: begin // Control Register
-                        if (avs_writedata[0]) ctrl_start <= 1; // Start Command
+                        if (avs_writedata[0]) begin // Start Command
+                            // SRC[1:0] != DST[1:0]: 전송하지 않고 바로 Done (Error)
+                            ctrl_align_err <= (ctrl_src_addr[1:0] != ctrl_dst_addr[1:0]);
+                            if (ctrl_src_addr[1:0] != ctrl_dst_addr[1:0])
+                                ctrl_done_reg <= 1;
+                            else
+                                ctrl_start <= 1;
+                        end
                     end
                     3'd1: begin // Status Register
                         if (avs_writedata[0]) ctrl_done_reg <= 0; // Clear Done
                     end
                     3'd2: ctrl_src_addr <= avs_writedata;  // Source Address
                     3'd3: ctrl_dst_addr <= avs_writedata;  // Destination Address
-                    3'd4: begin // Length (Bytes)
-                        // Burst 단위(Byte)로 정렬 (Padding)하여 Underrun 방지
-                        // 예: 1000 -> 1024, 1025 -> 2048
-                        // 수식: (len + (Burst*4 - 1)) & ~(Burst*4 - 1)
-                        // 주의: 사용자가 Read Burst Count를 먼저 설정해야 정확함
-                        ctrl_len <= (avs_writedata + ((ctrl_rd_burst*4)-1)) & ~((ctrl_rd_burst*4)-1); 
-                    end
+                    3'd4: ctrl_len <= avs_writedata;       // Length (Bytes)
                     3'd5: ctrl_rd_burst <= avs_writedata[8:0]; // Set Read Burst Count
                     3'd6: ctrl_wr_burst <= avs_writedata[8:0]; // Set Write Burst Count
+                    3'd7: ctrl_irq_en   <= avs_writedata[0];   // IRQ Enable
                 endcase
             end
         end
@@ -204,12 +306,13 @@ module burst_master #(
     always @(*) begin
         case (avs_address)
             3'd0: avs_readdata = {31'b0, ctrl_start};
-            3'd1: avs_readdata = {31'b0, ctrl_done_reg};
+            3'd1: avs_readdata = {29'b0, ctrl_align_err, ctrl_busy, ctrl_done_reg};
             3'd2: avs_readdata = ctrl_src_addr;
             3'd3: avs_readdata = ctrl_dst_addr;
             3'd4: avs_readdata = ctrl_len;
             3'd5: avs_readdata = {23'b0, ctrl_rd_burst};
             3'd6: avs_readdata = {23'b0, ctrl_wr_burst};
+            3'd7: avs_readdata = {irq, 30'b0, ctrl_irq_en};
             default: avs_readdata = 32'b0;
         endcase
     end
@@ -223,6 +326,7 @@ module burst_master #(
      * 
      * [변경점]
      * 고정된 BURST_COUNT 대신 프로그래머블 ctrl_rd_burst를 사용합니다.
+     * 남은 길이가 버스트보다 짧으면 마지막 버스트를 남은 Word 수로 줄입니다.
      */
 
     localparam [1:0] IDLE = 2'b00,
@@ -231,8 +335,11 @@ module burst_master #(
 
     reg [1:0] rm_state;
 
-    always @(posedge clk or negedge reset_n) begin
-        if (!reset_n) begin
+    wire [8:0] rd_burst_now = ((read_remaining_len >> 2) < run_rd_burst) ?
+                              read_remaining_len[10:2] : run_rd_burst;
+
+    always @(posedge dma_clk or negedge dma_reset_n) begin
+        if (!dma_reset_n) begin
             rm_state <= IDLE;
             rm_address <= 0;
             rm_read <= 0;
@@ -262,10 +369,10 @@ module burst_master #(
             // -----------------------------------------------------------------
             case (rm_state)
                 IDLE: begin
-                    if (ctrl_start) begin
-                        // 전송 시작: 주소와 길이 래치
-                        current_src_addr <= ctrl_src_addr;
-                        read_remaining_len <= ctrl_len;
+                    if (dma_start) begin
+                        // 전송 시작: 주소와 길이 래치 (Word 정렬)
+                        current_src_addr <= ctrl_src_addr & ~32'd3;
+                        read_remaining_len <= len_words;
                         rm_state <= WAIT_FIFO;
                     end
                 end
@@ -274,11 +381,11 @@ module burst_master #(
                     // 아직 읽을 데이터가 남았는지 확인
                     if (read_remaining_len > 0) begin
                         // FIFO 공간 체크: (현재 사용량 + 대기 중 + 새 요청) <= 전체 깊이
-                        if ((fifo_used + pending_reads + ctrl_rd_burst) <= FIFO_DEPTH) begin
+                        if ((fifo_used + pending_reads + rd_burst_now) <= FIFO_DEPTH) begin
                             // 공간 충분: Read 명령 준비
                             rm_address <= current_src_addr;
                             rm_read <= 1;
-                            rm_burstcount <= ctrl_rd_burst; // Use dynamic burst count
+                            rm_burstcount <= rd_burst_now; // 마지막 버스트는 짧아질 수 있음
                             rm_state <= READ;
                         end
                         // 공간 부족: 대기 (FIFO가 비워질 때까지)
@@ -293,8 +400,8 @@ module burst_master #(
                         
                         // 다음 Burst를 위한 주소/길이 갱신
                         // 주소: +Burst 워드
-                        current_src_addr <= current_src_addr + (ctrl_rd_burst * 4);
-                        read_remaining_len <= read_remaining_len - (ctrl_rd_burst * 4);
+                        current_src_addr <= current_src_addr + (rm_burstcount * 4);
+                        read_remaining_len <= read_remaining_len - (rm_burstcount * 4);
                         
                         rm_state <= WAIT_FIFO;  // 다시 공간 확인으로
                     end
@@ -323,6 +430,7 @@ module burst_master #(
      * 
      * [변경점]
      * 고정된 BURST_COUNT 대신 프로그래머블 ctrl_wr_burst를 사용합니다.
+     * 읽기와 같이 마지막 버스트는 남은 Word 수로 줄입니다.
      */
 
     localparam [1:0] W_IDLE = 2'b00,
@@ -332,21 +440,30 @@ module burst_master #(
     reg [1:0] wm_fsm;
     reg [8:0] wm_word_cnt;  // Burst 내 전송된 워드 수
 
+    wire [8:0] wr_burst_now = ((remaining_len >> 2) < run_wr_burst) ?
+                              remaining_len[10:2] : run_wr_burst;
+
     // FIFO Read 제어: Burst 중이고, Slave가 준비되었고, 아직 다 안 보냈으면 읽기
-    // 주의: wm_burstcount는 W_BURST 진입 시 ctrl_wr_burst로 래치됨
+    // 주의: wm_burstcount는 W_BURST 진입 시 run_wr_burst로 래치됨
     assign fifo_rd_en = (wm_fsm == W_BURST) && (!wm_waitrequest) && (wm_word_cnt < wm_burstcount);
     
     // Write Data는 FIFO 출력을 바로 연결
     assign wm_writedata = fifo_rd_data;
 
-    always @(posedge clk or negedge reset_n) begin
-        if (!reset_n) begin
+    // Byteenable: 전송의 첫 Word는 Head, 마지막 Word는 Tail Byte만 씀 (한 Word면 둘 다)
+    wire wr_first_word = (remaining_len == len_total) && (wm_word_cnt == 0);
+    wire wr_last_word  = ((remaining_len >> 2) == wm_word_cnt + 1);
+    assign wm_byteenable = (wr_first_word ? run_be_head : 4'hF) & (wr_last_word ? run_be_tail : 4'hF);
+
+    always @(posedge dma_clk or negedge dma_reset_n) begin
+        if (!dma_reset_n) begin
             wm_fsm <= W_IDLE;
             wm_write <= 0;
             wm_word_cnt <= 0;
             wm_address <= 0;
             current_dst_addr <= 0;
             remaining_len <= 0;
+            len_total <= 0;
             internal_done_pulse <= 0;
             wm_burstcount <= BURST_COUNT; // Initial value
         end else begin
@@ -355,10 +472,11 @@ module burst_master #(
             case (wm_fsm)
                 W_IDLE: begin
                     wm_write <= 0;
-                    if (ctrl_start) begin
-                        // 전송 시작: 목적지 주소와 길이 래치
-                        current_dst_addr <= ctrl_dst_addr;
-                        remaining_len <= ctrl_len;
+                    if (dma_start) begin
+                        // 전송 시작: 목적지 주소와 길이 래치 (Word 정렬)
+                        current_dst_addr <= ctrl_dst_addr & ~32'd3;
+                        remaining_len <= len_words;
+                        len_total <= len_words;
                         wm_fsm <= W_WAIT_DATA;
                     end
                 end
@@ -370,10 +488,10 @@ module burst_master #(
                         // 모든 데이터 전송 완료!
                         internal_done_pulse <= 1;  // Done 플래그 설정
                         wm_fsm <= W_IDLE;
-                    end else if (fifo_used >= ctrl_wr_burst) begin
+                    end else if (fifo_used >= wr_burst_now) begin
                         // FIFO에 Burst 분량만큼 데이터가 준비됨
                         wm_address <= current_dst_addr;
-                        wm_burstcount <= ctrl_wr_burst; // Use dynamic burst count
+                        wm_burstcount <= wr_burst_now; // 마지막 버스트는 짧아질 수 있음
                         wm_write <= 1;  // Burst 시작 (FIFO FWFT라 데이터 이미 준비됨)
                         wm_word_cnt <= 0;
                         wm_fsm <= W_BURST;
@@ -426,8 +544,8 @@ module burst_master #(
         .DATA_WIDTH(DATA_WIDTH),
         .FIFO_DEPTH(FIFO_DEPTH)
     ) u_fifo (
-        .clk     (clk),
-        .rst_n   (reset_n),
+        .clk     (dma_clk),
+        .rst_n   (dma_reset_n),
         .wr_en   (fifo_wr_en),
         .wr_data (fifo_wr_data),
         .rd_en   (fifo_rd_en),
@@ -20,6 +20,199 @@
  * 
  * - Latency: 4 Cycles
  * - Throughput: 1 Data per Clock (if no back pressure)
+ *
+ * [Clock Domain]
+ * - clk     : CSR (Nios II, 50MHz)
+ * - dma_clk : Read/Write Master, FIFO, Pipeline (100~150MHz 가능)
+ * 두 클럭이 같아도 동작합니다 (CDC 지연 몇 클럭만 추가됨).
+ *
+ * [Burst Shaping]
+ * 버스트가 BOUNDARY(기본 4KB, AXI 경계)를 넘으면 인터커넥트가 쪼개므로
+ * 주소 생성기가 직접 정렬된 버스트를 만듭니다.
+ * - Burst 크기가 2의 거듭제곱이면 Burst 크기(Byte) 경계에, 아니면 BOUNDARY에 맞춥니다.
+ * - 첫 버스트는 다음 경계까지, 마지막 버스트는 남은 길이만큼 짧아지고
+ *   그 사이는 정렬된 최대 버스트로 나갑니다.
+ * - 짧아진(Split) 버스트 수는 SPLIT_CNT 레지스터로 확인합니다.
+ *
+ * [CSR Map] (Word Offset)
+ * 0: CTRL [0] Start, [1] Descriptor Start    1: STATUS [0] Done (W1C), [1] Busy, [2] Align Error
+ * 2: SRC                 3: DST
+ * 4: LEN (Bytes, 2D에서는 한 줄 Byte 수, [Byte 단위 길이] 참고)   5: RD_BURST
+ * 6: WR_BURST            7: COEFF
+ * 8: SPLIT_CNT (RO) [15:0] Read Split, [31:16] Write Split (마지막 완료된 전송 기준)
+ * 9: QOS  [15:0] Rate (Read Words/us, 0 = 제한 없음), [16] Urgent Enable, [31] Urgent (RO)
+ * 10: QOS_STALL (RO) QoS 때문에 버스트를 내지 못한 dma_clk 사이클 수 (마지막 전송 기준)
+ * 11: DESC_ADDR 첫 Descriptor 주소 (64 Byte 정렬)
+ * 12: DESC_CNT (RO) 마지막 체인에서 완료된 Descriptor 수
+ * 13: HEIGHT (줄 수, 0/1 = 1D)   14: SRC_STRIDE (Bytes)   15: DST_STRIDE (Bytes)
+ * 16: FILL [2:0] Mode, [6:4] Pattern 길이-1, [31:16] Bar 폭 (Words)
+ * 17~24: FILL_PAT0~7
+ * 25: PIX_OP [3:0] Pixel ALU 연산 (0 = COEFF)   26: PIX_PARAM (연산별 파라미터)
+ * 27: SRC_B 두 번째 소스 주소 (Dual-Source 연산에서만 사용)
+ * 28: FMT [1:0] 소스 Format, [5:4] 목적지 Format (0 = XRGB32, 1 = RGB888, 2 = RGB565, 3 = YUYV)
+ * 29: SCALE_SIZE [15:0] 목적지 가로 픽셀 (0 = Resize 끔), [31:16] 목적지 줄 수
+ * 30: SCALE_STEP_X  31: SCALE_STEP_Y  목적지 1픽셀당 소스 이동량 (16.16)
+ * 32: ROTATE [2:0] 0 = 끔, 1 = 90, 2 = 180, 3 = 270 (시계 방향), 4 = 좌우, 5 = 상하, 6 = Transpose
+ * 33: BIST [1:0] 0 = 끔, 1 = Write, 2 = Verify, [5:4] Pattern   34: BIST_SEED
+ * 35: BIST_ERR_CNT (RO)  36: BIST_ERR_ADDR (RO)  37: BIST_ERR_DATA (RO)  38: BIST_ERR_EXP (RO)
+ * 39: IRQ_EN [0] Done 인터럽트 Enable, [31] IRQ Pending (RO)
+ * 40~46: 성능 카운터 (RO, 마지막 완료된 전송 기준, dma_clk 사이클)
+ *   40: PERF_BUSY      Start ~ Done 전체 사이클
+ *   41: PERF_RD_STALL  rm_read && rm_waitrequest     42: PERF_WR_STALL  wm_write && wm_waitrequest
+ *   43: PERF_WR_WAIT   쓰기 마스터가 W_WAIT_DATA에서 버스트를 내지 못한 사이클 (데이터 부족 / QoS)
+ *   44: PERF_RD_BURSTS 수락된 읽기 버스트 수          45: PERF_WR_BURSTS 쓰기 버스트 수
+ *   46: PERF_FIFO_PEAK [15:0] fifo_in 최대 사용량, [31:16] fifo_out 최대 사용량 (Word)
+ * 47: CUT_THROUGH [0] 쓰기 Cut-through Enable
+ * 48~53: Command Queue ([Command Queue] 참고)
+ *   48: CQ_PUSH (WO) Descriptor 주소 Push   49: CQ_STATUS [4:0] 대기 명령 수, [8] Full (RO),
+ *                                            [16] Overflow (W1C)
+ *   50: CQ_RING Completion Ring 주소 (16 Byte 정렬)   51: CQ_RING_SIZE Entry 수 (2의 거듭제곱, 0 = 끔)
+ *   52: CQ_HEAD (RO) 엔진이 기록한 Entry 수          53: CQ_TAIL 소프트웨어가 소비한 Entry 수
+ *
+ * [Pixel ALU]
+ * 파이프라인 Stage 1/2에서 XRGB(8:8:8:8) 픽셀을 채널별로 처리합니다. X Byte는 그대로 둡니다.
+ *   0: COEFF      기존 벤치마크 연산 (Word * COEFF / 400)
+ *   1: PASS       그대로 복사
+ *   2: BRIGHT     c = sat((c - 128) * Gain / 128 + 128 + Offset)
+ *                 PARAM [8:0] Gain (128 = 1.0), [24:16] Offset (Signed)
+ *   3: GRAY       Y = (77R + 150G + 29B) >> 8, R = G = B = Y
+ *   4: SWIZZLE    출력 Byte n = 입력 Byte PARAM[2n+1:2n] (0xE4 = 그대로, 0xC6 = R/B 교환)
+ *   5: THRESHOLD  Y >= PARAM[7:0] 이면 흰색, 아니면 검은색
+ *   6: INVERT     c = 255 - c
+ *   7: ADD_SAT    c = min(c + PARAM의 같은 채널, 255)
+ * - 곱셈은 Stage 0->1, 나머지는 Stage 1->2에서 끝나므로 여전히 1 Word/Clock입니다.
+ *
+ * [Dual-Source] PIX_OP >= 8: A = SRC, B = SRC_B 두 프레임을 읽어 A op B를 씁니다.
+ *   8: BLEND      c = (A * Alpha + B * (256 - Alpha)) >> 8, PARAM [8:0] Alpha (256 = A만)
+ *   9: ABSDIFF    c = |A - B|
+ *   10: MIN       11: MAX
+ *   12: ADD_SAT   c = min(A + B, 255)
+ * - 읽기 마스터가 같은 길이의 버스트를 A, B 순서로 번갈아 냅니다. (A/B 둘 다 정렬되도록 짧은 쪽 길이)
+ * - Avalon 응답은 요청 순서대로 오므로 버스트 길이 Tag FIFO로 데이터를 u_fifo_in / u_fifo_b로 나눕니다.
+ * - 두 FIFO에 모두 데이터가 있을 때 Stage 0가 한 쌍을 받습니다. X Byte는 A를 따릅니다.
+ * - 2D에서는 두 소스 모두 SRC_STRIDE를 씁니다. 읽기 대역폭이 두 배이므로 QoS 토큰도 두 배 소모합니다.
+ *
+ * [2D Mode]
+ * HEIGHT > 1이면 LEN Byte짜리 줄을 HEIGHT번 옮깁니다. 줄마다 SRC/DST에 STRIDE를 더합니다.
+ * 버스트는 줄 안에서만 정렬/분할되고, 줄과 줄 사이를 넘지 않습니다.
+ *
+ * [Fill Mode]
+ * FILL Mode가 0이 아니면 읽기 마스터를 쓰지 않고 쓰기 마스터가 생성된 데이터를 씁니다.
+ * (Frame Buffer Clear, Test Pattern) LEN/HEIGHT/DST_STRIDE는 그대로 적용되고 SRC는 무시합니다.
+ *   1: Constant  모든 워드 = PAT0
+ *   2: Pattern   PAT0 ~ PAT[N-1]을 워드마다 반복
+ *   3: Bars      PAT0 ~ PAT[N-1]을 Bar 폭 워드마다 바꿈 (Color Bar)
+ *   4: Gradient  PAT0에서 시작해 워드마다 PAT1을 더함 (32bit 덧셈)
+ * - 생성기는 줄마다 처음부터 다시 시작합니다.
+ * - FIFO를 기다리지 않으므로 쓰기 대역폭 그대로 나갑니다. 파이프라인(COEFF)은 거치지 않습니다.
+ * - Register Mode 전용입니다. Descriptor 체인의 전송은 항상 복사입니다.
+ *
+ * [Format 변환]
+ * FMT가 0이 아니면 Input FIFO 뒤의 pixel_unpack이 소스 Format을 XRGB 픽셀로 풀고,
+ * 파이프라인 뒤의 pixel_pack이 목적지 Format으로 다시 묶습니다. (Pixel ALU와 함께 사용 가능)
+ * - LEN은 XRGB 기준 Byte 수(픽셀 수 x 4)입니다. 변환 시 16 Byte(4 픽셀) 단위로 올리고
+ *   읽기/쓰기 길이를 각 Format의 Byte 수로 환산합니다. (예: RGB888 -> XRGB: 3/4 읽고 1 쓰기)
+ * - SRC_STRIDE / DST_STRIDE는 각 Format의 실제 Byte 간격입니다.
+ * - Fill 모드와 Dual-Source 연산에서는 변환하지 않습니다.
+ *
+ * [Resize]
+ * SCALE_SIZE가 0이 아니면 pixel_unpack 뒤의 pixel_scaler가 소스 사각형
+ * (LEN/4 x HEIGHT 픽셀)을 Bilinear 보간으로 SCALE_SIZE 크기로 바꿔 Stage 0에 넣습니다.
+ * - 쓰기 마스터는 목적지 가로 x 4 Byte짜리 줄을 목적지 줄 수만큼 DST_STRIDE 간격으로 씁니다.
+ * - STEP = (소스 크기 << 16) / 목적지 크기는 소프트웨어가 계산합니다. (축소/확대 모두)
+ * - 소스 2줄을 Line Buffer(M10K)에 두고 보간하므로 소스는 2x2 이상, 가로 2048 이하입니다.
+ * - Pixel ALU / Format 변환과 함께 쓸 수 있습니다. (목적지가 XRGB가 아니면 가로는 4의 배수)
+ * - Format 변환 시 줄 끝의 채움 픽셀(4 픽셀 단위 올림)은 보간에 쓰지 않습니다. (소스 가로 = LEN/4)
+ * - 크기/STEP은 Start 시점 값으로 고정됩니다.
+ * - 소스를 끝까지 읽은 뒤 Done이 올라갑니다. Register Mode 전용입니다.
+ *
+ * [Rotate]
+ * ROTATE가 0이 아니면 소스 사각형(LEN/4 x HEIGHT 픽셀)을 16x16 타일로 나눠 회전/뒤집기합니다.
+ * - 회전 전체가 Job 하나이고 타일 Sequencer가 타일마다 읽기/쓰기 주소를 바꿉니다.
+ *   (소스 16줄 x 64 Byte 읽기 -> pixel_tile에서 순서 변경 -> 목적지 16줄 x 64 Byte 쓰기)
+ *   그래서 읽기/쓰기 모두 16 Word 버스트이고, CPU처럼 열 방향으로 4 Byte씩 흩어 쓰지 않습니다.
+ * - 목적지는 DST부터 회전된 크기(90/270/Transpose는 HEIGHT x LEN/4)로 DST_STRIDE 간격입니다.
+ * - pixel_tile이 Ping-Pong이므로 타일 N을 내보내고 쓰는 동안 타일 N+1을 읽고 받습니다.
+ *   16x16 타일 하나에 최소 256 클럭이고, 읽기/쓰기 중 느린 쪽이 속도를 정합니다.
+ * - XRGB32 전용이며 Pixel ALU(Dual-Source 제외)와 함께 쓸 수 있습니다.
+ *   Fill / Dual-Source에서는 무시되고, Format 변환 / Resize는 꺼집니다. Register Mode 전용입니다.
+ *
+ * [BIST]
+ * BIST Mode가 0이 아니면 다른 설정(Fill / PIX_OP / FMT / Resize / Rotate / HEIGHT)을 무시하고
+ * 메모리 검사를 합니다. 생성기는 워드마다 아래 Pattern을 만듭니다. (addr = 워드의 Byte 주소)
+ *   0: ADDR  addr ^ SEED          1: WALK  (1 << addr[6:2]) ^ SEED (SEED = ~0이면 Walking Zeros)
+ *   2: LFSR  SEED에서 시작하는 32bit Galois LFSR (SEED = 0이면 1)
+ *   3: ALT   addr[2] ? ~SEED : SEED (SEED = 0x55555555이면 Checkerboard)
+ * - Write:  DST부터 LEN Byte를 Pattern으로 채웁니다. (Fill과 같은 경로, 쓰기 대역폭 그대로)
+ * - Verify: SRC부터 LEN Byte를 읽어 같은 생성기와 비교합니다. 쓰기는 하지 않습니다.
+ *   불일치 수와 첫 불일치의 주소 / 읽은 값 / 기대값을 BIST_ERR_*에 남깁니다. (Start마다 지움)
+ *
+ * [Cut-through]
+ * 기본(Store-and-Forward)은 Output FIFO에 버스트 하나 분량이 모여야 쓰기 버스트를 냅니다.
+ * CUT_THROUGH를 켜면 이미 발행한 읽기 버스트가 이번 쓰기 버스트를 다 채울 수 있을 때
+ * (읽기 발행 Word - 쓰기 발행 Word >= 버스트 길이) Output FIFO에 첫 Word가 오자마자 시작합니다.
+ * - 버스트 도중 데이터가 비면 wm_write를 잠시 내립니다. (Avalon 버스트 중 Write 해제 허용)
+ *   필요한 데이터는 이미 읽기 요청이 나가 있으므로 버스트는 반드시 끝납니다.
+ * - 읽기 Word와 쓰기 Word가 1:1인 Job에만 적용됩니다.
+ *   (Format 변환 / Resize / Rotate / Dual-Source / Fill / BIST에서는 Store-and-Forward)
+ * - 버스트 하나 분량의 대기 시간이 없어지므로 짧은 전송에서 효과가 큽니다.
+ *
+ * [Byte 단위 길이]
+ * Word가 1:1로 옮겨지는 Job(Format 변환 / Resize / Rotate / BIST 제외, Fill / Dual-Source 포함)은
+ * LEN을 Byte 단위로 지키고 목적지 범위 밖은 쓰지 않습니다.
+ * - 정렬된 주소(SRC/DST & ~3)부터 DST[1:0] + LEN을 Word로 올린 만큼 읽고 씁니다.
+ *   Burst Shaping이 그대로 적용되어 마지막 버스트만 짧아집니다.
+ * - 각 줄의 첫 Word는 DST[1:0] 이후 Byte만, 마지막 Word는 LEN 안의 Byte만
+ *   wm_byteenable로 씁니다.
+ * - Byte를 옮기는 회로는 없으므로 SRC[1:0] (Dual-Source면 SRC_B[1:0]도)이 DST[1:0]과 같아야 하고,
+ *   2D에서는 STRIDE가 4의 배수여야 합니다. 어긋난 Job은 읽지도 쓰지도 않고 바로 끝나며
+ *   (전송 Byte 0) STATUS[2] Align Error가 올라갑니다. 체인 / Queue는 다음 Descriptor로 진행합니다.
+ * - Descriptor STATUS와 Completion의 Byte 수는 wm_byteenable로 실제 쓴 Byte 수입니다 (= LEN x HEIGHT).
+ * - 나머지 Job은 LEN을 4 Byte 단위로 올립니다 (픽셀 단위 처리).
+ *
+ * [Interrupt]
+ * irq = Done && IRQ_EN (clk 도메인 Level). STATUS에 1을 써서 Done을 지우면 내려갑니다.
+ * Register / Descriptor / Rotate 모두 전송 전체가 끝났을 때 한 번 올라갑니다.
+ * CPU는 Start 후 STATUS를 Polling하지 않고 ISR(Nios) 또는 UIO read()(Linux)로 기다립니다.
+ *
+ * [Descriptor Mode]
+ * DDR에 Descriptor Linked List를 만들고 DESC_ADDR 설정 후 CTRL[1]을 한 번 쓰면
+ * 엔진이 Descriptor를 읽어 차례로 실행합니다. (Doorbell 1회, Busy-Poll 없음)
+ * Descriptor (16 Word, 64 Byte):
+ *   0: NEXT    다음 Descriptor 주소 (0 = 끝)
+ *   1: STATUS  엔진이 Write-back: [31] Done, [30:0] 전송한 Byte 수
+ *   2: SRC     3: DST     4: LEN (Byte)
+ *   5: BURST   [8:0] RD_BURST, [24:16] WR_BURST
+ *   6: COEFF   7: FLAGS [0] LAST (NEXT와 상관없이 여기서 종료)
+ *   8: HEIGHT  9: SRC_STRIDE   10: DST_STRIDE
+ *   11: PIX_OP 12: PIX_PARAM   13: SRC_B   14: FMT   15: Reserved (0)
+ * - Descriptor는 읽기 마스터로 16 Word 버스트 1회로 읽고,
+ *   STATUS는 쓰기 마스터로 1 Word 씁니다.
+ * - STATUS Done은 체인 전체가 끝났을 때 한 번 올라갑니다.
+ * - SPLIT_CNT / QOS_STALL은 체인 전체 합계입니다. QOS는 체인 시작 시 한 번 래치합니다.
+ *
+ * [Command Queue]
+ * CPU가 다음 명령을 준비하는 동안 엔진이 놀지 않도록 명령을 미리 쌓아 둡니다.
+ * - CQ_PUSH에 Descriptor 주소를 쓰면 16 Entry Dual-Clock FIFO에 들어갑니다.
+ *   Write 한 번이 명령 하나이므로 Nios와 HPS(Lightweight 브릿지)가 동시에 넣어도 섞이지 않습니다.
+ *   FIFO가 가득 차면 버리고 Overflow를 올립니다.
+ * - 엔진이 비어 있으면 하나를 꺼내 CTRL[1]과 같은 Descriptor 체인으로 실행합니다.
+ * - 명령이 끝나면 Completion Ring[CQ_HEAD % SIZE]에 16 Byte Entry를 쓰고 CQ_HEAD를 올린 뒤
+ *   Done(IRQ)을 올립니다. Ring이 가득 차면(HEAD - TAIL == SIZE) 다음 명령을 꺼내지 않습니다.
+ *     0: Descriptor 주소   1: [31] Done, [30:0] 명령 전체 Byte 수
+ *     2: 시작 시각          3: 끝 시각 (dma_clk Free-running Cycle Counter)
+ * - HEAD / TAIL은 16bit Free-running입니다. 초기화할 때 TAIL = HEAD로 맞춥니다.
+ *   HEAD는 Gray Code로, TAIL은 Toggle Handshake로 클럭 도메인을 건넙니다.
+ * - Queue가 돌고 있는 동안 CTRL Start를 쓰면 안 됩니다.
+ *   SPLIT_CNT / QOS_STALL / PERF는 CTRL Start 기준이므로 Queue 명령은 Ring의 시각으로 잽니다.
+ *
+ * [QoS]
+ * 스캔아웃(video_dma)과 같은 F2H 경로를 쓰므로 Bulk 복사가 화면을 굶기지 않도록 합니다.
+ * - Token Bucket: 1us마다 Rate만큼 토큰(Word)이 쌓이고, 읽기 버스트가 길이만큼 소모합니다.
+ *   버킷 크기는 읽기 버스트 2개입니다. 쓰기는 읽은 데이터만큼만 나가므로 전체 대역폭은
+ *   Rate x 8 Byte/us (읽기 + 쓰기) 이하로 제한됩니다.
+ * - Urgent: 스캔아웃 FIFO가 비어갈 때 qos_urgent가 올라오면 (Urgent Enable 시)
+ *   새 읽기/쓰기 버스트를 멈춥니다. 이미 나간 버스트는 끝까지 진행합니다.
  */
 
 module burst_master_4 #(
@@ -27,19 +220,27 @@ module burst_master_4 #(
     parameter ADDR_WIDTH = 32,
     parameter BURST_COUNT = 256,
     parameter FIFO_DEPTH = 512,
-    parameter PIPE_LATENCY = 4
+    parameter PIPE_LATENCY = 4,
+    parameter BOUNDARY = 4096,      // Bytes, 2의 거듭제곱 (AXI 4KB / DDR Row)
+    parameter DMA_CLK_MHZ = 100     // Token Bucket 1us 기준 (dma_clk 주파수)
 )(
-    input  wire                   clk,
+    input  wire                   clk,          // CSR Clock
     input  wire                   reset_n,
+    input  wire                   dma_clk,      // Master/Pipeline Clock
+    input  wire                   dma_reset_n,
 
-    // CSR Interface
+    // QoS (비동기 입력, 스캔아웃 FIFO 부족 시 1)
+    input  wire                   qos_urgent,
+
+    // CSR Interface (clk domain)
     input  wire                   avs_write,
     input  wire                   avs_read,
-    input  wire [2:0]             avs_address,
+    input  wire [5:0]             avs_address,
     input  wire [31:0]            avs_writedata,
     output reg  [31:0]            avs_readdata,
+    output wire                   irq,          // Done Interrupt (clk domain, Level)
 
-    // Read Master
+    // Read Master (dma_clk domain)
     output reg  [ADDR_WIDTH-1:0]  rm_address,
     output reg                    rm_read,
     input  wire [DATA_WIDTH-1:0]  rm_readdata,
@@ -47,11 +248,12 @@ module burst_master_4 #(
     output reg  [8:0]             rm_burstcount,
     input  wire                   rm_waitrequest,
 
-    // Write Master
+    // Write Master (dma_clk domain)
     output reg  [ADDR_WIDTH-1:0]  wm_address,
     output reg                    wm_write,
     output wire [DATA_WIDTH-1:0]  wm_writedata,
     output reg  [8:0]             wm_burstcount,
+    output wire [DATA_WIDTH/8-1:0] wm_byteenable,
     input  wire                   wm_waitrequest
 );
 
@@ -64,8 +266,13 @@ module burst_master_4 #(
     wire [DATA_WIDTH-1:0] fifo_in_wr_data, fifo_in_rd_data;
     wire [$clog2(FIFO_DEPTH):0] fifo_in_used;
 
-    reg fifo_out_wr_en;
-    reg [DATA_WIDTH-1:0] fifo_out_wr_data;
+    // Dual-Source: 두 번째 입력 FIFO (B)
+    wire fifo_b_wr_en, fifo_b_rd_en, fifo_b_full, fifo_b_empty;
+    wire [DATA_WIDTH-1:0] fifo_b_rd_data;
+    wire [$clog2(FIFO_DEPTH):0] fifo_b_used;
+
+    wire fifo_out_wr_en;
+    wire [DATA_WIDTH-1:0] fifo_out_wr_data;
     wire fifo_out_rd_en, fifo_out_full, fifo_out_empty;
     wire [DATA_WIDTH-1:0] fifo_out_rd_data;
     wire [$clog2(FIFO_DEPTH):0] fifo_out_used;
@@ -75,39 +282,482 @@ module burst_master_4 #(
     reg [ADDR_WIDTH-1:0] ctrl_src_addr, ctrl_dst_addr, ctrl_len;
     reg [31:0] ctrl_coeff;
     reg [8:0] ctrl_rd_burst, ctrl_wr_burst;
+    reg ctrl_busy;
+    reg ctrl_irq_en;
+    reg ctrl_cut_thru, run_cut_thru;
+    reg [3:0] run_be_head, run_be_tail;     // 줄의 첫 / 마지막 Word Byteenable
+    assign irq = ctrl_done_reg && ctrl_irq_en;
+
+    // dma_clk domain copies (latched on job_start, QoS on dma_start)
+    reg [31:0] run_coeff;
+    reg [3:0]  ctrl_pix_op, run_pix_op;
+    reg [31:0] ctrl_pix_param, run_pix_param;
+    wire       run_dual = run_pix_op[3];     // PIX_OP >= 8: Dual-Source
+    reg [ADDR_WIDTH-1:0] ctrl_src_b;
+
+    // Format 변환
+    localparam [1:0] F_XRGB = 2'd0, F_RGB888 = 2'd1, F_RGB565 = 2'd2, F_YUYV = 2'd3;
+    reg [1:0] ctrl_src_fmt, ctrl_dst_fmt, run_src_fmt, run_dst_fmt;
+    reg [ADDR_WIDTH-1:0] current_srcb_addr, rd_line_b_addr;
+
+    // Resize (전송 중 변경 금지, Quasi-static)
+    reg [15:0] ctrl_scale_w, ctrl_scale_h;          // 목적지 크기 (픽셀, 0 = 끔)
+    reg [31:0] ctrl_scale_step_x, ctrl_scale_step_y; // 16.16
+    reg        run_scale;
+    reg [15:0] run_scale_src_w, run_scale_line_w, run_scale_src_h;
+    reg [15:0] run_scale_dst_w, run_scale_dst_h;
+    reg [31:0] run_scale_step_x, run_scale_step_y;
+
+    // Rotate (Job 하나, 타일 단위로 읽기 / 쓰기 주소를 바꿔 가며 실행)
+    localparam TILE = 16;
+    localparam [2:0] ROT_OFF = 3'd0, ROT_90 = 3'd1, ROT_180 = 3'd2, ROT_270 = 3'd3,
+                     ROT_FLIP_H = 3'd4, ROT_FLIP_V = 3'd5, ROT_TRANSPOSE = 3'd6;
+    reg [2:0]            ctrl_rot_mode;
+    reg                  rot_active, rot_done, rot_job_start, run_rot;
+    reg [15:0]           rot_tx, rot_ty;            // 읽는 타일의 소스 좌표 (픽셀)
+    reg [7:0]            rot_tw, rot_th;
+    reg [15:0]           rot_lx, rot_ly;            // pixel_tile이 받는 타일
+    reg [7:0]            rot_lw, rot_lh;
+    reg [15:0]           rot_wx, rot_wy;            // 쓰는 타일 (소스 좌표)
+    reg [7:0]            rot_ww, rot_wh;
+    reg                  rot_rd_next, rot_wr_next;  // 읽기 / 쓰기 마스터에 다음 타일 주소 (1 클럭)
+    wire                 rot_wr_hold;               // 쓰기 마스터: 남은 타일이 있어 Done 보류
+    reg [ADDR_WIDTH-1:0] rot_src, rot_dst;
+
+    // BIST (Pattern Write / Read-back Verify)
+    localparam [1:0] BIST_OFF = 2'd0, BIST_WRITE = 2'd1, BIST_VERIFY = 2'd2;
+    localparam [1:0] PAT_ADDR = 2'd0, PAT_WALK = 2'd1, PAT_LFSR = 2'd2, PAT_ALT = 2'd3;
+    reg [1:0]            ctrl_bist_mode, ctrl_bist_pat;
+    reg [31:0]           ctrl_bist_seed;
+    reg                  run_bist_verify;
+    reg [ADDR_WIDTH-1:0] bist_addr;             // 현재 워드의 Byte 주소
+    reg [31:0]           bist_lfsr;
+    reg [ADDR_WIDTH-1:0] bist_cmp_left;         // 남은 비교 워드 수
+    reg [31:0]           bist_err_cnt, bist_err_addr, bist_err_data, bist_err_exp;
+    reg [31:0]           ctrl_bist_err_cnt, ctrl_bist_err_addr;  // clk domain copy, captured on Done
+    reg [31:0]           ctrl_bist_err_data, ctrl_bist_err_exp;
+
+    // Dual-Source 응답 분배: A/B 버스트 쌍의 길이를 요청 순서대로 저장
+    reg [8:0] tag_len [0:15];
+    reg [3:0] tag_wr, tag_rd;
+    reg [4:0] tag_cnt;
+    reg [8:0] rsp_beat;
+    reg       rsp_b;                          // 현재 응답이 B 버스트
+    reg [8:0] run_rd_burst, run_wr_burst;
+
+    // Split burst counters (dma_clk domain, cleared on dma_start)
+    reg [15:0] rd_split_cnt, wr_split_cnt;
+    reg [31:0] ctrl_split_cnt;              // clk domain copy, captured on Done
+
+    // QoS
+    reg [15:0] ctrl_qos_rate, run_qos_rate; // Read Words per us (0 = Off)
+    reg        ctrl_urgent_en, run_urgent_en;
+    reg [31:0] qos_stall_cnt;               // dma_clk domain, cleared on dma_start
+    reg [31:0] ctrl_qos_stall;              // clk domain copy, captured on Done
+    reg        align_err;                   // dma_clk domain, Byte 위치가 어긋난 Job이 있었음
+    reg        ctrl_align_err;              // clk domain copy, captured on Done
+
+    // Performance Counters (dma_clk domain, cleared on dma_start)
+    localparam PERF_N = 6;
+    localparam P_BUSY = 0, P_RD_STALL = 1, P_WR_STALL = 2, P_WR_WAIT = 3,
+               P_RD_BURSTS = 4, P_WR_BURSTS = 5;
+    reg [31:0] perf_cnt [0:PERF_N-1];
+    reg [31:0] ctrl_perf [0:PERF_N-1];      // clk domain copy, captured on Done
+    reg        perf_busy;
+    reg [$clog2(FIFO_DEPTH):0] perf_in_peak, perf_out_peak;
+    reg [31:0] ctrl_perf_peak;              // [15:0] fifo_in, [31:16] fifo_out
+
+    // Descriptor Mode
+    localparam DESC_WORDS = 16;
+    reg                  ctrl_desc_mode;    // CTRL[1]로 시작한 전송
+    reg [ADDR_WIDTH-1:0] ctrl_desc_addr;
+    reg [15:0]           ctrl_desc_cnt;     // clk domain copy, captured on Done
+
+    reg [31:0]           desc_word [0:DESC_WORDS-1];
+    reg [ADDR_WIDTH-1:0] desc_ptr;          // 현재 Descriptor 주소
+    reg [3:0]            desc_beat;
+    reg [15:0]           desc_cnt;
+    reg                  chain_active, chain_done;
+    reg                  seq_fetch_go, seq_job_start, seq_wb_go;
+    reg                  fetch_done, wb_done;
+
+    // Command Queue (CSR Push -> Dual-Clock FIFO -> Descriptor Sequencer)
+    localparam CQ_AW = 4;                   // 16 Entry
+    wire                 cq_push, cq_pop, cq_full, cq_empty;
+    wire [ADDR_WIDTH-1:0] cq_q;
+    wire [CQ_AW-1:0]     cq_level;
+    reg                  ctrl_cq_ovf;       // Full 상태에서 Push (Sticky)
+    reg [ADDR_WIDTH-1:0] ctrl_cq_ring;      // Quasi-static
+    reg [15:0]           ctrl_cq_size, ctrl_cq_tail;
+    reg                  cq_tail_toggle;    // clk domain
+    reg [2:0]            cq_tail_sync;      // dma_clk domain
+    reg [15:0]           run_cq_tail;
+    reg [15:0]           cq_head, cq_head_gray;        // dma_clk domain
+    reg [15:0]           cq_head_sync1, cq_head_sync2; // clk domain
+    reg                  cq_active;         // 현재 체인이 Queue 명령
+    reg [ADDR_WIDTH-1:0] cq_cmd;
+    reg [31:0]           cq_time, cq_t_start, cq_t_end, cq_bytes;
+    reg                  seq_cpl_go, wb_cpl;
+
+    // 2D Mode
+    reg [15:0]           ctrl_height;
+    reg [ADDR_WIDTH-1:0] ctrl_src_stride, ctrl_dst_stride;
+    reg [ADDR_WIDTH-1:0] run_rd_width, run_wr_width;  // 한 줄 Byte 수 (Format 환산 후)
+    reg [ADDR_WIDTH-1:0] run_src_stride, run_dst_stride;
+    reg [ADDR_WIDTH-1:0] rd_line_addr, wr_line_addr;    // 현재 줄의 시작 주소
+    reg [15:0]           rd_lines_left, wr_lines_left;
+    reg [ADDR_WIDTH-1:0] wr_bytes_done;                 // Descriptor STATUS용
+
+    // Fill Mode
+    localparam [2:0] FILL_OFF = 3'd0, FILL_CONST = 3'd1, FILL_PATTERN = 3'd2,
+                     FILL_BARS = 3'd3, FILL_GRADIENT = 3'd4,
+                     FILL_BIST = 3'd5;          // 내부용: BIST Write
+    reg [2:0]            ctrl_fill_mode, run_fill_mode;
+    reg [2:0]            ctrl_fill_last, run_fill_last;     // Pattern 길이 - 1
+    reg [15:0]           ctrl_bar_width, run_bar_width;
+    reg [31:0]           ctrl_fill_pat [0:7];   // 전송 중 변경 금지 (Quasi-static)
+    reg [2:0]            fill_idx;
+    reg [15:0]           fill_run;
+    reg [31:0]           fill_acc;
 
     // FSM support
     reg [ADDR_WIDTH-1:0] current_src_addr, current_dst_addr;
     reg [ADDR_WIDTH-1:0] read_remaining_len, remaining_len; 
     reg [ADDR_WIDTH-1:0] pending_reads; 
     
-    localparam [1:0] IDLE = 2'b00, READ = 2'b01, WAIT_FIFO = 2'b10;
-    localparam [1:0] W_IDLE = 2'b00, W_WAIT_DATA = 2'b01, W_BURST = 2'b10;
-    reg [1:0] rm_state, wm_fsm;
+    localparam [2:0] IDLE = 3'd0, READ = 3'd1, WAIT_FIFO = 3'd2, D_READ = 3'd3, D_WAIT = 3'd4,
+                     READ_B = 3'd5;
+    localparam [1:0] W_IDLE = 2'b00, W_WAIT_DATA = 2'b01, W_BURST = 2'b10, W_DESC = 2'b11;
+    reg [2:0] rm_state;
+    reg [1:0] wm_fsm;
     reg [8:0] wm_word_cnt;
 
+    // =========================================================================
+    // Clock Domain Crossing (clk <-> dma_clk)
+    // =========================================================================
+    // - Start : clk -> dma_clk (Toggle Synchronizer)
+    // - Done  : dma_clk -> clk (Toggle Synchronizer)
+    // - SRC/DST/LEN/BURST/COEFF 레지스터는 Start 전에 설정되고 전송 중에는 바뀌지 않는
+    //   정적 신호(Quasi-static)입니다. Toggle이 동기화되는 2~3 클럭 동안 이미 안정되어 있으므로
+    //   dma_start 시점에 dma_clk 쪽으로 한 번 래치해서 사용합니다.
+    reg       start_toggle;                 // clk domain
+    reg [2:0] start_sync;                   // dma_clk domain
+    wire      dma_start = start_sync[2] ^ start_sync[1];
+
+    reg       done_toggle;                  // dma_clk domain
+    reg [2:0] done_sync;                    // clk domain
+    wire      csr_done_pulse = done_sync[2] ^ done_sync[1];
+
+    // Descriptor 체인 / Rotate 중에는 전체가 끝날 때만 Done
+    wire      xfer_done = (internal_done_pulse && !chain_active && !rot_active) || chain_done || rot_done;
+
+    // Job: 레지스터 모드는 CSR 값, Descriptor 모드는 Descriptor 값으로 한 번의 전송을 실행
+    // Rotate는 회전 전체가 Job 하나 (첫 타일 값으로 시작, 다음 타일 주소는 rot_rd_next / rot_wr_next)
+    // BIST는 다른 모드보다 우선 (Register Mode 전용, 1D, 파이프라인을 거치지 않음)
+    wire                  job_bist     = !chain_active && (ctrl_bist_mode != BIST_OFF);
+    wire                  job_bist_verify = job_bist && (ctrl_bist_mode == BIST_VERIFY);
+    wire                  rot_en       = (ctrl_rot_mode != ROT_OFF) && (ctrl_fill_mode == FILL_OFF) &&
+                                         !ctrl_pix_op[3] && (ctrl_bist_mode == BIST_OFF);
+    wire                  rot_swap     = (ctrl_rot_mode == ROT_90) || (ctrl_rot_mode == ROT_270) ||
+                                         (ctrl_rot_mode == ROT_TRANSPOSE);
+    wire                  job_start    = (dma_start && !ctrl_desc_mode && !rot_en) || seq_job_start ||
+                                         rot_job_start;
+    wire [ADDR_WIDTH-1:0] job_src_raw  = chain_active ? desc_word[2] : rot_active ? rot_src : ctrl_src_addr;
+    wire [ADDR_WIDTH-1:0] job_dst_raw  = chain_active ? desc_word[3] : rot_active ? rot_dst : ctrl_dst_addr;
+    wire [ADDR_WIDTH-1:0] job_src      = job_src_raw & ~32'd3;
+    wire [ADDR_WIDTH-1:0] job_dst      = job_dst_raw & ~32'd3;
+    wire [ADDR_WIDTH-1:0] job_len_raw  = chain_active ? desc_word[4] : rot_active ? {rot_tw, 2'b00} : ctrl_len;
+    wire [8:0]            job_rd_burst = chain_active ? desc_word[5][8:0] : ctrl_rd_burst;
+    wire [8:0]            job_wr_burst = chain_active ? desc_word[5][24:16] : ctrl_wr_burst;
+    wire [31:0]           job_coeff    = chain_active ? desc_word[6] : ctrl_coeff;
+    wire [3:0]            job_pix_op   = chain_active ? desc_word[11][3:0] : job_bist ? 4'd0 : ctrl_pix_op;
+    wire [31:0]           job_pix_param = chain_active ? desc_word[12] : ctrl_pix_param;
+    wire [ADDR_WIDTH-1:0] job_src_b_raw = chain_active ? desc_word[13] : ctrl_src_b;
+    wire [ADDR_WIDTH-1:0] job_src_b    = job_src_b_raw & ~32'd3;
+    wire [15:0]           job_height_raw = chain_active ? desc_word[8][15:0] : ctrl_height;
+    wire [15:0]           job_height   = rot_active ? {8'b0, rot_th} : job_bist ? 16'd1 :
+                                         (job_height_raw == 0) ? 16'd1 : job_height_raw;
+    wire [ADDR_WIDTH-1:0] job_src_stride = chain_active ? desc_word[9] : ctrl_src_stride;
+    wire [ADDR_WIDTH-1:0] job_dst_stride = chain_active ? desc_word[10] : ctrl_dst_stride;
+    wire [2:0]            job_fill_mode  = chain_active ? FILL_OFF :
+                                           job_bist ? (job_bist_verify ? FILL_OFF : FILL_BIST) :
+                                           ctrl_fill_mode;
+
+    // Format 변환: Fill / Dual-Source / Rotate / BIST에서는 끔
+    wire [1:0] job_src_fmt = (job_fill_mode != FILL_OFF || job_pix_op[3] || rot_active || job_bist) ? F_XRGB :
+                             chain_active ? desc_word[14][1:0] : ctrl_src_fmt;
+    wire [1:0] job_dst_fmt = (job_fill_mode != FILL_OFF || rot_active) ? F_XRGB :
+                             chain_active ? desc_word[14][5:4] : ctrl_dst_fmt;
+    wire       job_conv    = (job_src_fmt != F_XRGB) || (job_dst_fmt != F_XRGB);
+
+    // Resize: Register Mode 전용, Fill / Dual-Source / Rotate / BIST에서는 끔
+    wire       job_scale   = !chain_active && !rot_active && !job_bist && (ctrl_scale_w != 0) &&
+                             (job_fill_mode == FILL_OFF) && !job_pix_op[3];
+    wire [15:0] scale_dst_h   = (ctrl_scale_h == 0) ? 16'd1 : ctrl_scale_h;
+    // 쓰는 타일의 회전된 크기: 90/270/Transpose는 가로/세로가 바뀜
+    wire [7:0]  rot_dst_tw    = rot_swap ? rot_wh : rot_ww;
+    wire [7:0]  rot_dst_th    = rot_swap ? rot_ww : rot_wh;
+    wire [15:0] job_wr_height = job_scale  ? scale_dst_h :
+                                rot_active ? {8'b0, rot_dst_th} : job_height;
+
+    // Byte 단위 길이: 1:1 Word Job은 DST[1:0]만큼 앞으로 늘려 Word로 올리고 첫/마지막 Byte를 가림
+    wire       job_exact = !job_conv && !job_scale && !rot_active && !job_bist;
+    wire [1:0] job_head  = job_exact ? job_dst_raw[1:0] : 2'd0;
+    wire [1:0] job_end   = job_exact ? job_len_raw[1:0] + job_head : 2'd0;   // 마지막 Word 유효 Byte (0 = 4)
+    wire [ADDR_WIDTH-1:0] job_len = (job_len_raw + job_head + 3) & ~32'd3;
+    // Byte를 옮기는 회로가 없으므로 소스의 Byte 위치가 DST와 다르면 실행하지 않음 (Fill은 소스 없음)
+    wire       job_reads    = (job_fill_mode == FILL_OFF);
+    wire       job_misalign = job_exact && (
+                   (job_reads && job_src_raw[1:0] != job_dst_raw[1:0]) ||
+                   (job_reads && job_pix_op[3] && job_src_b_raw[1:0] != job_dst_raw[1:0]) ||
+                   (job_height > 1 && ((job_reads && job_src_stride[1:0] != 0) || job_dst_stride[1:0] != 0)));
+
+    // 픽셀 수 -> Format별 Byte 수
+    function [ADDR_WIDTH-1:0] fmt_bytes;
+        input [ADDR_WIDTH-1:0] px;
+        input [1:0]            fmt;
+        begin
+            case (fmt)
+                F_XRGB:   fmt_bytes = px << 2;
+                F_RGB888: fmt_bytes = (px << 1) + px;
+                default:  fmt_bytes = px << 1;
+            endcase
+        end
+    endfunction
+
+    wire [ADDR_WIDTH-1:0] job_px     = ((job_len + 15) >> 4) << 2;   // 4 픽셀 단위로 올림
+    wire [ADDR_WIDTH-1:0] job_rd_len = job_conv ? fmt_bytes(job_px, job_src_fmt) : job_len;
+    // Resize: 보간은 실제 픽셀 수(src_w)까지, 줄 끝 판정은 pixel_unpack이 내는 픽셀 수(line_w)로
+    wire [ADDR_WIDTH-1:0] job_src_w  = job_len >> 2;
+    wire [ADDR_WIDTH-1:0] job_line_w = job_conv ? job_px : job_len >> 2;
+    wire [ADDR_WIDTH-1:0] job_wr_len = job_bist_verify ? {ADDR_WIDTH{1'b0}} :   // 읽기만 함
+                                       job_scale  ? fmt_bytes(ctrl_scale_w, job_dst_fmt) :
+                                       rot_active ? {rot_dst_tw, 2'b00} :
+                                       job_conv   ? fmt_bytes(job_px, job_dst_fmt) : job_len;
+    // Cut-through: 읽은 Word가 그대로 쓰기 Word가 되는 Job
+    wire                  job_1to1   = !job_conv && !job_scale && !rot_active && !job_pix_op[3] &&
+                                       (job_fill_mode == FILL_OFF) && !job_bist;
+
+    always @(posedge dma_clk or negedge dma_reset_n) begin
+        if (!dma_reset_n) begin
+            start_sync <= 3'b0;
+            done_toggle <= 1'b0;
+            run_coeff <= 1; run_rd_burst <= BURST_COUNT; run_wr_burst <= BURST_COUNT;
+            run_pix_op <= 0; run_pix_param <= 0;
+            run_qos_rate <= 0; run_urgent_en <= 0;
+            run_rd_width <= 0; run_wr_width <= 0; run_src_stride <= 0; run_dst_stride <= 0;
+            run_src_fmt <= F_XRGB; run_dst_fmt <= F_XRGB;
+            run_fill_mode <= FILL_OFF; run_fill_last <= 0; run_bar_width <= 1;
+            run_scale <= 0; run_scale_src_w <= 0; run_scale_line_w <= 0; run_scale_src_h <= 0;
+            run_scale_dst_w <= 0; run_scale_dst_h <= 0; run_scale_step_x <= 0; run_scale_step_y <= 0;
+            run_rot <= 0;
+            run_bist_verify <= 0;
+            run_cut_thru <= 0;
+            run_be_head <= 4'hF; run_be_tail <= 4'hF;
+        end else begin
+            start_sync <= {start_sync[1:0], start_toggle};
+            if (xfer_done) done_toggle <= ~done_toggle;
+            if (job_start) begin
+                run_coeff <= job_coeff;
+                run_pix_op <= job_pix_op;
+                run_pix_param <= job_pix_param;
+                run_rd_burst <= job_rd_burst;
+                run_wr_burst <= job_wr_burst;
+                run_rd_width <= job_rd_len;
+                run_wr_width <= job_wr_len;
+                run_src_fmt <= job_src_fmt;
+                run_dst_fmt <= job_dst_fmt;
+                run_scale <= job_scale;
+                run_scale_src_w <= job_src_w[15:0];
+                run_scale_line_w <= job_line_w[15:0];
+                run_scale_src_h <= job_height;
+                // 목적지 크기도 Job 동안 고정 (다음 전송 설정이 끝난 Job의 생성을 다시 열지 않도록)
+                run_scale_dst_w <= ctrl_scale_w;
+                run_scale_dst_h <= job_scale ? scale_dst_h : 16'd0;        // 끄면 생성 안 함
+                run_scale_step_x <= ctrl_scale_step_x;
+                run_scale_step_y <= ctrl_scale_step_y;
+                run_rot <= rot_active;
+                run_bist_verify <= job_bist_verify;
+                run_cut_thru <= ctrl_cut_thru && job_1to1;
+                run_be_head <= 4'hF << job_head;
+                run_be_tail <= (job_end == 0) ? 4'hF : 4'hF >> (3'd4 - job_end);
+                run_src_stride <= job_src_stride;
+                run_dst_stride <= job_dst_stride;
+                run_fill_mode <= job_fill_mode;
+                run_fill_last <= ctrl_fill_last;
+                run_bar_width <= (ctrl_bar_width == 0) ? 16'd1 : ctrl_bar_width;
+            end
+            // Rotate: 다음 타일의 한 줄 Byte 수 (가장자리 타일은 작음)
+            if (rot_rd_next) run_rd_width <= {rot_tw, 2'b00};
+            if (rot_wr_next) run_wr_width <= {rot_dst_tw, 2'b00};
+            if (dma_start || cq_pop) begin
+                run_qos_rate <= ctrl_qos_rate;
+                run_urgent_en <= ctrl_urgent_en;
+            end
+        end
+    end
+
+    // Align Error: 전송(체인 / Queue 명령) 안의 Job 중 하나라도 어긋나면 Done까지 유지
+    always @(posedge dma_clk or negedge dma_reset_n) begin
+        if (!dma_reset_n)                   align_err <= 0;
+        else if (job_start && job_misalign) align_err <= 1;    // Register Mode는 dma_start와 같은 클럭
+        else if (dma_start || cq_pop)       align_err <= 0;
+    end
+
+    always @(posedge clk or negedge reset_n) begin
+        if (!reset_n) done_sync <= 3'b0;
+        else done_sync <= {done_sync[1:0], done_toggle};
+    end
+
+    // CQ_HEAD: dma_clk -> clk (Gray Code, 한 번에 1씩만 증가)
+    always @(posedge clk or negedge reset_n) begin
+        if (!reset_n) begin
+            cq_head_sync1 <= 0; cq_head_sync2 <= 0;
+        end else begin
+            cq_head_sync1 <= cq_head_gray;
+            cq_head_sync2 <= cq_head_sync1;
+        end
+    end
+
+    function [15:0] gray2bin16;
+        input [15:0] g;
+        integer i;
+        begin
+            gray2bin16[15] = g[15];
+            for (i = 14; i >= 0; i = i - 1) gray2bin16[i] = gray2bin16[i+1] ^ g[i];
+        end
+    endfunction
+
+    // Urgent: 레벨 신호이므로 Double Flop (dma_clk 제어용, clk 상태 표시용)
+    reg [1:0] urgent_sync_dma, urgent_sync_csr;
+    always @(posedge dma_clk or negedge dma_reset_n) begin
+        if (!dma_reset_n) urgent_sync_dma <= 2'b0;
+        else urgent_sync_dma <= {urgent_sync_dma[0], qos_urgent};
+    end
+    always @(posedge clk or negedge reset_n) begin
+        if (!reset_n) urgent_sync_csr <= 2'b0;
+        else urgent_sync_csr <= {urgent_sync_csr[0], qos_urgent};
+    end
+
+    // =========================================================================
+    // QoS: Token Bucket & Urgent Hold (dma_clk domain)
+    // =========================================================================
+    localparam US_CNT_W = $clog2(DMA_CLK_MHZ);
+    reg [US_CNT_W-1:0] us_cnt;
+    wire               us_tick = (us_cnt == DMA_CLK_MHZ - 1);
+
+    reg  [17:0] tokens;
+    wire [17:0] token_cap = {run_rd_burst, 1'b0};   // 읽기 버스트 2개
+    wire        qos_hold  = run_urgent_en && urgent_sync_dma[1];
+
     // =========================================================================
     // CSR & FSM (Same as burst_master.v / burst_master_3.v)
     // =========================================================================
     // ... CSR Logic ...
+    integer f;
     always @(posedge clk or negedge reset_n) begin
         if (!reset_n) begin
-            ctrl_start <= 0; ctrl_done_reg <= 0;
+            ctrl_start <= 0; ctrl_done_reg <= 0; ctrl_busy <= 0; start_toggle <= 0;
+            ctrl_split_cnt <= 0;
+            ctrl_qos_rate <= 0; ctrl_urgent_en <= 0; ctrl_qos_stall <= 0; ctrl_align_err <= 0;
+            ctrl_desc_mode <= 0; ctrl_desc_addr <= 0; ctrl_desc_cnt <= 0;
+            ctrl_height <= 0; ctrl_src_stride <= 0; ctrl_dst_stride <= 0;
+            ctrl_fill_mode <= FILL_OFF; ctrl_fill_last <= 0; ctrl_bar_width <= 0;
+            for (f = 0; f < 8; f = f + 1) ctrl_fill_pat[f] <= 0;
             ctrl_src_addr <= 0; ctrl_dst_addr <= 0; ctrl_len <= 0;
             ctrl_coeff <= 1; ctrl_rd_burst <= BURST_COUNT; ctrl_wr_burst <= BURST_COUNT;
+            ctrl_pix_op <= 0; ctrl_pix_param <= 0; ctrl_src_b <= 0;
+            ctrl_src_fmt <= F_XRGB; ctrl_dst_fmt <= F_XRGB;
+            ctrl_scale_w <= 0; ctrl_scale_h <= 0; ctrl_scale_step_x <= 0; ctrl_scale_step_y <= 0;
+            ctrl_rot_mode <= ROT_OFF;
+            ctrl_bist_mode <= BIST_OFF; ctrl_bist_pat <= PAT_ADDR; ctrl_bist_seed <= 0;
+            ctrl_bist_err_cnt <= 0; ctrl_bist_err_addr <= 0;
+            ctrl_bist_err_data <= 0; ctrl_bist_err_exp <= 0;
+            ctrl_irq_en <= 0; ctrl_cut_thru <= 0;
+            ctrl_cq_ovf <= 0; ctrl_cq_ring <= 0; ctrl_cq_size <= 0; ctrl_cq_tail <= 0;
+            cq_tail_toggle <= 0;
+            for (f = 0; f < PERF_N; f = f + 1) ctrl_perf[f] <= 0;
+            ctrl_perf_peak <= 0;
         end else begin
-            if (ctrl_start) ctrl_start <= 0;
-            if (internal_done_pulse) ctrl_done_reg <= 1;
+            if (ctrl_start) begin
+                ctrl_start <= 0;
+                start_toggle <= ~start_toggle;
+                ctrl_busy <= 1;
+            end
+            if (csr_done_pulse) begin
+                ctrl_done_reg <= 1;
+                ctrl_busy <= 0;
+                // Done 시점에는 카운터가 멈춰 있으므로 그대로 복사 (다음 Start까지 유지)
+                ctrl_split_cnt <= {wr_split_cnt, rd_split_cnt};
+                ctrl_qos_stall <= qos_stall_cnt;
+                ctrl_align_err <= align_err;
+                ctrl_desc_cnt <= desc_cnt;
+                ctrl_bist_err_cnt <= bist_err_cnt;
+                ctrl_bist_err_addr <= bist_err_addr;
+                ctrl_bist_err_data <= bist_err_data;
+                ctrl_bist_err_exp <= bist_err_exp;
+                for (f = 0; f < PERF_N; f = f + 1) ctrl_perf[f] <= perf_cnt[f];
+                ctrl_perf_peak[15:0] <= perf_in_peak;
+                ctrl_perf_peak[31:16] <= perf_out_peak;
+            end
             if (avs_write) begin
                 case (avs_address)
-                    0: if (avs_writedata[0]) ctrl_start <= 1;
+                    0: if (avs_writedata[1:0] != 0) begin
+                        ctrl_start <= 1;
+                        ctrl_desc_mode <= avs_writedata[1];
+                        ctrl_align_err <= 0;
+                    end
                     1: if (avs_writedata[0]) ctrl_done_reg <= 0;
                     2: ctrl_src_addr <= avs_writedata;
                     3: ctrl_dst_addr <= avs_writedata;
-                    4: ctrl_len <= (avs_writedata + ((ctrl_rd_burst*4)-1)) & ~((ctrl_rd_burst*4)-1);
+                    4: ctrl_len <= avs_writedata;   // Byte 그대로 (Burst Shaping + Byteenable이 처리)
                     5: ctrl_rd_burst <= avs_writedata[8:0];
                     6: ctrl_wr_burst <= avs_writedata[8:0];
                     7: ctrl_coeff <= avs_writedata;
+                    9: begin
+                        ctrl_qos_rate <= avs_writedata[15:0];
+                        ctrl_urgent_en <= avs_writedata[16];
+                    end
+                    11: ctrl_desc_addr <= avs_writedata;
+                    13: ctrl_height <= avs_writedata[15:0];
+                    14: ctrl_src_stride <= avs_writedata;
+                    15: ctrl_dst_stride <= avs_writedata;
+                    16: begin
+                        ctrl_fill_mode <= avs_writedata[2:0];
+                        ctrl_fill_last <= avs_writedata[6:4];
+                        ctrl_bar_width <= avs_writedata[31:16];
+                    end
+                    17, 18, 19, 20, 21, 22, 23, 24:
+                        ctrl_fill_pat[avs_address - 6'd17] <= avs_writedata;
+                    25: ctrl_pix_op <= avs_writedata[3:0];
+                    26: ctrl_pix_param <= avs_writedata;
+                    27: ctrl_src_b <= avs_writedata;
+                    28: begin
+                        ctrl_src_fmt <= avs_writedata[1:0];
+                        ctrl_dst_fmt <= avs_writedata[5:4];
+                    end
+                    29: begin
+                        ctrl_scale_w <= avs_writedata[15:0];
+                        ctrl_scale_h <= avs_writedata[31:16];
+                    end
+                    30: ctrl_scale_step_x <= avs_writedata;
+                    31: ctrl_scale_step_y <= avs_writedata;
+                    32: ctrl_rot_mode <= avs_writedata[2:0];
+                    33: begin
+                        ctrl_bist_mode <= avs_writedata[1:0];
+                        ctrl_bist_pat <= avs_writedata[5:4];
+                    end
+                    34: ctrl_bist_seed <= avs_writedata;
+                    39: ctrl_irq_en <= avs_writedata[0];
+                    47: ctrl_cut_thru <= avs_writedata[0];
+                    48: if (cq_full) ctrl_cq_ovf <= 1;      // Push는 cq_push가 FIFO에 직접 씀
+                    49: if (avs_writedata[16]) ctrl_cq_ovf <= 0;
+                    50: ctrl_cq_ring <= avs_writedata & ~32'hF;
+                    51: ctrl_cq_size <= avs_writedata[15:0];
+                    53: begin
+                        ctrl_cq_tail <= avs_writedata[15:0];
+                        cq_tail_toggle <= ~cq_tail_toggle;
+                    end
                 endcase
             end
         end
@@ -115,53 +765,284 @@ module burst_master_4 #(
 
     always @(*) begin
         case (avs_address)
-            0: avs_readdata = {31'b0, ctrl_start};
-            1: avs_readdata = {31'b0, ctrl_done_reg};
+            0: avs_readdata = {30'b0, ctrl_desc_mode, ctrl_start};
+            1: avs_readdata = {29'b0, ctrl_align_err, ctrl_busy, ctrl_done_reg}; // [1] Busy (CDC 포함)
             2: avs_readdata = ctrl_src_addr;
             3: avs_readdata = ctrl_dst_addr;
             4: avs_readdata = ctrl_len;
             5: avs_readdata = {23'b0, ctrl_rd_burst};
             6: avs_readdata = {23'b0, ctrl_wr_burst};
             7: avs_readdata = ctrl_coeff;
+            8: avs_readdata = ctrl_split_cnt;
+            9: avs_readdata = {urgent_sync_csr[1], 14'b0, ctrl_urgent_en, ctrl_qos_rate};
+            10: avs_readdata = ctrl_qos_stall;
+            11: avs_readdata = ctrl_desc_addr;
+            12: avs_readdata = {16'b0, ctrl_desc_cnt};
+            13: avs_readdata = {16'b0, ctrl_height};
+            14: avs_readdata = ctrl_src_stride;
+            15: avs_readdata = ctrl_dst_stride;
+            16: avs_readdata = {ctrl_bar_width, 9'b0, ctrl_fill_last, 1'b0, ctrl_fill_mode};
+            17, 18, 19, 20, 21, 22, 23, 24:
+                avs_readdata = ctrl_fill_pat[avs_address - 6'd17];
+            25: avs_readdata = {28'b0, ctrl_pix_op};
+            26: avs_readdata = ctrl_pix_param;
+            27: avs_readdata = ctrl_src_b;
+            28: avs_readdata = {26'b0, ctrl_dst_fmt, 2'b0, ctrl_src_fmt};
+            29: avs_readdata = {ctrl_scale_h, ctrl_scale_w};
+            30: avs_readdata = ctrl_scale_step_x;
+            31: avs_readdata = ctrl_scale_step_y;
+            32: avs_readdata = {29'b0, ctrl_rot_mode};
+            33: avs_readdata = {26'b0, ctrl_bist_pat, 2'b0, ctrl_bist_mode};
+            34: avs_readdata = ctrl_bist_seed;
+            35: avs_readdata = ctrl_bist_err_cnt;
+            36: avs_readdata = ctrl_bist_err_addr;
+            37: avs_readdata = ctrl_bist_err_data;
+            38: avs_readdata = ctrl_bist_err_exp;
+            39: avs_readdata = {irq, 30'b0, ctrl_irq_en};
+            40, 41, 42, 43, 44, 45:
+                avs_readdata = ctrl_perf[avs_address - 6'd40];
+            46: avs_readdata = ctrl_perf_peak;
+            47: avs_readdata = {31'b0, ctrl_cut_thru};
+            49: avs_readdata = {15'b0, ctrl_cq_ovf, 7'b0, cq_full, 3'b0,
+                                cq_full ? 5'd16 : {1'b0, cq_level}};
+            50: avs_readdata = ctrl_cq_ring;
+            51: avs_readdata = {16'b0, ctrl_cq_size};
+            52: avs_readdata = {16'b0, gray2bin16(cq_head_sync2)};
+            53: avs_readdata = {16'b0, ctrl_cq_tail};
             default: avs_readdata = 0;
         endcase
     end
 
+    // ... Burst Shaping ...
+    // 다음 경계까지 남은 워드 수: (align - (addr % align)) / 4
+    function [ADDR_WIDTH-1:0] words_to_align;
+        input [ADDR_WIDTH-1:0] addr;
+        input [8:0]            burst;
+        reg   [ADDR_WIDTH-1:0] align;
+        begin
+            if (((burst & (burst - 1)) == 0) && ((burst * 4) <= BOUNDARY))
+                align = burst * 4;
+            else
+                align = BOUNDARY;
+            words_to_align = (align - (addr & (align - 1))) >> 2;
+        end
+    endfunction
+
+    function [8:0] shape_burst;
+        input [ADDR_WIDTH-1:0] addr;
+        input [ADDR_WIDTH-1:0] remaining;   // Bytes
+        input [8:0]            burst;
+        reg   [ADDR_WIDTH-1:0] len;
+        begin
+            len = words_to_align(addr, burst);
+            if (len > burst) len = burst;
+            if (len > (remaining >> 2)) len = remaining >> 2;
+            shape_burst = len[8:0];
+        end
+    endfunction
+
+    // Dual-Source: A/B 버스트 길이가 같아야 하므로 둘 다 정렬되는 짧은 쪽을 씀
+    wire [8:0] rd_burst_a    = shape_burst(current_src_addr, read_remaining_len, run_rd_burst);
+    wire [8:0] rd_burst_b    = shape_burst(current_srcb_addr, read_remaining_len, run_rd_burst);
+    wire [8:0] rd_next_burst = (run_dual && rd_burst_b < rd_burst_a) ? rd_burst_b : rd_burst_a;
+    wire [9:0] rd_cost       = run_dual ? {rd_next_burst, 1'b0} : {1'b0, rd_next_burst};
+    wire [8:0] wr_next_burst = shape_burst(current_dst_addr, remaining_len, run_wr_burst);
+
+    // ... Burst Issue Conditions (FIFO + QoS) ...
+    // pending_reads는 A/B 합계이므로 Dual에서는 보수적으로 두 FIFO 모두 검사
+    wire rd_ready     = (rm_state == WAIT_FIFO) && (read_remaining_len > 0) &&
+                        ((fifo_in_used + pending_reads + rd_cost) <= FIFO_DEPTH) &&
+                        (!run_dual || (((fifo_b_used + pending_reads + rd_cost) <= FIFO_DEPTH) &&
+                                       (tag_cnt != 16)));
+    wire rd_tokens_ok = (run_qos_rate == 0) || (tokens >= rd_cost);
+    wire rd_issue     = rd_ready && rd_tokens_ok && !qos_hold;
+
+    // Cut-through: 이번 버스트 분량이 이미 읽기 발행되었으면 첫 Word만 있어도 시작
+    reg  [ADDR_WIDTH-1:0] ct_words;          // 읽기 발행 Word - 쓰기 발행 Word (Job 단위)
+    wire ct_ready     = run_cut_thru && (ct_words >= wr_next_burst) && !fifo_out_empty;
+    wire wr_ready     = (wm_fsm == W_WAIT_DATA) && (remaining_len != 0) &&
+                        ((run_fill_mode != FILL_OFF) || (fifo_out_used >= wr_next_burst) || ct_ready);
+    wire wr_issue     = wr_ready && !qos_hold;
+
+    always @(posedge dma_clk or negedge dma_reset_n) begin
+        if (!dma_reset_n) begin
+            ct_words <= 0;
+        end else if (job_start) begin
+            ct_words <= 0;
+        end else begin
+            ct_words <= ct_words + ((rm_state == READ && !rm_waitrequest) ? rm_burstcount : 9'd0)
+                                 - (wr_issue ? wr_next_burst : 9'd0);
+        end
+    end
+
+    wire qos_stall    = (rd_ready && !rd_issue) || (wr_ready && !wr_issue);
+
+    // ... Token Bucket ...
+    wire [17:0] tokens_next = tokens + (us_tick ? run_qos_rate : 18'd0)
+                                     - (rd_issue ? rd_cost : 18'd0);
+
+    always @(posedge dma_clk or negedge dma_reset_n) begin
+        if (!dma_reset_n) begin
+            us_cnt <= 0; tokens <= 0; qos_stall_cnt <= 0;
+        end else begin
+            us_cnt <= us_tick ? 0 : us_cnt + 1;
+            if (dma_start) qos_stall_cnt <= 0;
+            if (job_start) begin
+                tokens <= {job_rd_burst, 1'b0};     // 버킷을 채운 상태로 시작
+            end else begin
+                if (run_qos_rate == 0)
+                    tokens <= token_cap;
+                else
+                    tokens <= (tokens_next > token_cap) ? token_cap : tokens_next;
+                if (qos_stall) qos_stall_cnt <= qos_stall_cnt + 1;
+            end
+        end
+    end
+
+    // =========================================================================
+    // Performance Counters (dma_clk domain)
+    // =========================================================================
+    // Start부터 전송 전체의 Done까지 셉니다. 32bit이므로 100MHz에서 약 42초까지 유효합니다.
+    // 읽기/쓰기 Stall이 많으면 메모리 쪽, WR_WAIT가 많으면 읽기/파이프라인 쪽이 병목입니다.
+    integer p;
+    always @(posedge dma_clk or negedge dma_reset_n) begin
+        if (!dma_reset_n) begin
+            perf_busy <= 0; perf_in_peak <= 0; perf_out_peak <= 0;
+            for (p = 0; p < PERF_N; p = p + 1) perf_cnt[p] <= 0;
+        end else if (dma_start) begin
+            perf_busy <= 1; perf_in_peak <= 0; perf_out_peak <= 0;
+            for (p = 0; p < PERF_N; p = p + 1) perf_cnt[p] <= 0;
+        end else if (perf_busy) begin
+            if (xfer_done) perf_busy <= 0;
+            perf_cnt[P_BUSY] <= perf_cnt[P_BUSY] + 1;
+            if (rm_read && rm_waitrequest)
+                perf_cnt[P_RD_STALL] <= perf_cnt[P_RD_STALL] + 1;
+            if (wm_write && wm_waitrequest)
+                perf_cnt[P_WR_STALL] <= perf_cnt[P_WR_STALL] + 1;
+            if (wm_fsm == W_WAIT_DATA && remaining_len != 0 && !wr_issue)
+                perf_cnt[P_WR_WAIT] <= perf_cnt[P_WR_WAIT] + 1;
+            if ((rm_state == READ || rm_state == READ_B) && !rm_waitrequest)
+                perf_cnt[P_RD_BURSTS] <= perf_cnt[P_RD_BURSTS] + 1;
+            if (wr_issue)
+                perf_cnt[P_WR_BURSTS] <= perf_cnt[P_WR_BURSTS] + 1;
+            if (fifo_in_used > perf_in_peak) perf_in_peak <= fifo_in_used;
+            if (fifo_out_used > perf_out_peak) perf_out_peak <= fifo_out_used;
+        end
+    end
+
     // ... Read Master FSM ...
-    assign fifo_in_wr_en = rm_readdatavalid;
+    // Descriptor를 읽는 동안(D_WAIT) 들어오는 데이터는 FIFO가 아니라 desc_word로 갑니다.
+    wire rsp_data = rm_readdatavalid && (rm_state != D_WAIT);
+    assign fifo_in_wr_en = rsp_data && !(run_dual && rsp_b);
+    assign fifo_b_wr_en  = rsp_data && run_dual && rsp_b;
     assign fifo_in_wr_data = rm_readdata;
 
-    always @(posedge clk or negedge reset_n) begin
-        if (!reset_n) begin
+    integer k;
+    always @(posedge dma_clk or negedge dma_reset_n) begin
+        if (!dma_reset_n) begin
             rm_state <= IDLE; rm_address <= 0; rm_read <= 0; rm_burstcount <= BURST_COUNT;
             current_src_addr <= 0; pending_reads <= 0; read_remaining_len <= 0;
+            rd_split_cnt <= 0;
+            desc_beat <= 0; fetch_done <= 0;
+            rd_line_addr <= 0; rd_lines_left <= 0;
+            current_srcb_addr <= 0; rd_line_b_addr <= 0;
+            tag_wr <= 0; tag_rd <= 0; tag_cnt <= 0; rsp_beat <= 0; rsp_b <= 0;
+            for (k = 0; k < 16; k = k + 1) tag_len[k] <= 0;
+            for (k = 0; k < DESC_WORDS; k = k + 1) desc_word[k] <= 0;
         end else begin
-            if (rm_state == READ && !rm_waitrequest) 
+            fetch_done <= 0;
+            if (dma_start) rd_split_cnt <= 0;
+
+            if ((rm_state == READ || rm_state == READ_B) && !rm_waitrequest)
                 pending_reads <= pending_reads + rm_burstcount - (rm_readdatavalid ? 1 : 0);
             else if (rm_readdatavalid && pending_reads > 0) 
                 pending_reads <= pending_reads - 1;
 
+            // Dual-Source 응답 분배: 쌍마다 A 버스트 -> B 버스트 순서
+            if (rsp_data && run_dual) begin
+                if (rsp_beat == tag_len[tag_rd] - 1) begin
+                    rsp_beat <= 0;
+                    rsp_b <= !rsp_b;
+                    if (rsp_b) tag_rd <= tag_rd + 1;
+                end else begin
+                    rsp_beat <= rsp_beat + 1;
+                end
+            end
+            // Tag Push (A 버스트 요청 수락) / Pop (B 버스트 응답 끝)
+            tag_cnt <= tag_cnt + ((rm_state == READ && !rm_waitrequest && run_dual) ? 1 : 0)
+                               - ((rsp_data && run_dual && rsp_b && rsp_beat == tag_len[tag_rd] - 1) ? 1 : 0);
+
             case (rm_state)
-                IDLE: if (ctrl_start) begin
-                    current_src_addr <= ctrl_src_addr;
-                    read_remaining_len <= ctrl_len;
+                IDLE: if (job_start && job_reads && !job_misalign) begin
+                    current_src_addr <= job_src;
+                    rd_line_addr <= job_src;
+                    current_srcb_addr <= job_src_b;
+                    rd_line_b_addr <= job_src_b;
+                    tag_wr <= 0; tag_rd <= 0; tag_cnt <= 0; rsp_beat <= 0; rsp_b <= 0;
+                    read_remaining_len <= job_rd_len;
+                    rd_lines_left <= job_height;
                     rm_state <= WAIT_FIFO;
+                end else if (seq_fetch_go) begin
+                    rm_address <= desc_ptr;
+                    rm_read <= 1;
+                    rm_burstcount <= DESC_WORDS;
+                    desc_beat <= 0;
+                    rm_state <= D_READ;
+                end
+                D_READ: if (!rm_waitrequest) begin
+                    rm_read <= 0;
+                    rm_state <= D_WAIT;
+                end
+                D_WAIT: if (rm_readdatavalid) begin
+                    desc_word[desc_beat] <= rm_readdata;
+                    desc_beat <= desc_beat + 1;
+                    if (desc_beat == DESC_WORDS - 1) begin
+                        fetch_done <= 1;
+                        rm_state <= IDLE;
+                    end
                 end
                 WAIT_FIFO: begin
-                    if (read_remaining_len > 0) begin
-                        if ((fifo_in_used + pending_reads + ctrl_rd_burst) <= FIFO_DEPTH) begin
-                            rm_address <= current_src_addr;
-                            rm_read <= 1;
-                            rm_burstcount <= ctrl_rd_burst;
-                            rm_state <= READ;
-                        end
+                    if (rot_rd_next) begin
+                        // Rotate: 앞 타일의 읽기를 다 냈으면 바로 다음 타일 (쓰기를 기다리지 않음)
+                        current_src_addr <= rot_src;
+                        rd_line_addr <= rot_src;
+                        read_remaining_len <= {rot_tw, 2'b00};
+                        rd_lines_left <= {8'b0, rot_th};
+                    end else if (rd_issue) begin
+                        rm_address <= current_src_addr;
+                        rm_read <= 1;
+                        rm_burstcount <= rd_next_burst;
+                        if (rd_next_burst != run_rd_burst) rd_split_cnt <= rd_split_cnt + 1;
+                        rm_state <= READ;
+                    end else if (read_remaining_len == 0 && rd_lines_left > 1) begin
+                        // 2D: 다음 줄
+                        current_src_addr <= rd_line_addr + run_src_stride;
+                        rd_line_addr <= rd_line_addr + run_src_stride;
+                        current_srcb_addr <= rd_line_b_addr + run_src_stride;
+                        rd_line_b_addr <= rd_line_b_addr + run_src_stride;
+                        read_remaining_len <= run_rd_width;
+                        rd_lines_left <= rd_lines_left - 1;
                     end
                     if (internal_done_pulse) rm_state <= IDLE;
                 end
                 READ: if (!rm_waitrequest) begin
+                    current_src_addr <= current_src_addr + (rm_burstcount * 4);
+                    if (run_dual) begin
+                        // 같은 길이의 B 버스트를 바로 이어서 냄
+                        tag_len[tag_wr] <= rm_burstcount;
+                        tag_wr <= tag_wr + 1;
+                        rm_address <= current_srcb_addr;
+                        rm_state <= READ_B;
+                    end else begin
+                        rm_read <= 0;
+                        read_remaining_len <= read_remaining_len - (rm_burstcount * 4);
+                        rm_state <= WAIT_FIFO;
+                    end
+                end
+                READ_B: if (!rm_waitrequest) begin
                     rm_read <= 0;
-                    current_src_addr <= current_src_addr + (ctrl_rd_burst * 4);
-                    read_remaining_len <= read_remaining_len - (ctrl_rd_burst * 4);
+                    current_srcb_addr <= current_srcb_addr + (rm_burstcount * 4);
+                    read_remaining_len <= read_remaining_len - (rm_burstcount * 4);
                     rm_state <= WAIT_FIFO;
                 end
             endcase
@@ -197,33 +1078,176 @@ module burst_master_4 #(
 
     // 1. Input FIFO -> Stage 0 Interface
     // Input FIFO가 비어있지 않으면(Valid), 그리고 Stage 0가 준비되면(Ready) 읽는다.
-    assign fifo_in_rd_en = !fifo_in_empty && pipeline_ready[0];
-    
-    // 2. Stage Output -> Output FIFO Interface
-    // Last Stage Logic
-    // Output FIFO가 Full이 아니면 Ready
-    assign pipeline_ready[PIPE_LATENCY] = !fifo_out_full;
+    // Input FIFO -> pixel_unpack (소스 Format -> XRGB) -> Stage 0
+    // Dual-Source: A/B가 모두 있을 때 한 쌍을 함께 읽음
+    // Resize: pixel_unpack -> pixel_scaler -> Stage 0
+    // Rotate: pixel_unpack -> pixel_tile -> Stage 0
+    wire        unpk_valid;
+    wire [31:0] unpk_data;
+    wire        scl_in_ready, scl_valid, scl_drained;
+    wire [31:0] scl_data;
+    wire        tile_in_ready, tile_valid;
+    wire [31:0] tile_data;
+    wire        b_ok       = !run_dual || !fifo_b_empty;
+    // BIST Verify: pixel_unpack 출력을 비교기가 바로 소비 (파이프라인은 비어 있음)
+    wire        in_valid   = run_scale ? scl_valid :
+                             run_rot   ? tile_valid :
+                             run_bist_verify ? 1'b0 : unpk_valid && b_ok;
+    wire        unpk_ready = run_scale ? scl_in_ready :
+                             run_rot   ? tile_in_ready :
+                             run_bist_verify ? 1'b1 : pipeline_ready[0] && b_ok;
+    assign fifo_b_rd_en = in_valid && pipeline_ready[0] && run_dual;
+
+    pixel_unpack u_unpack (
+        .clk(dma_clk), .rst_n(dma_reset_n),
+        .fmt(run_src_fmt), .clear(job_start),
+        .in_data(fifo_in_rd_data), .in_valid(!fifo_in_empty), .in_rd(fifo_in_rd_en),
+        .px_data(unpk_data), .px_valid(unpk_valid), .px_ready(unpk_ready)
+    );
+
+    pixel_scaler u_scaler (
+        .clk(dma_clk), .rst_n(dma_reset_n), .clear(job_start),
+        .src_w(run_scale_src_w), .line_w(run_scale_line_w), .src_h(run_scale_src_h),
+        .dst_w(run_scale_dst_w), .dst_h(run_scale_dst_h),
+        .step_x(run_scale_step_x), .step_y(run_scale_step_y),
+        .in_data(unpk_data), .in_valid(unpk_valid && run_scale), .in_ready(scl_in_ready),
+        .out_data(scl_data), .out_valid(scl_valid), .out_ready(pipeline_ready[0] && run_scale),
+        .drained(scl_drained)
+    );
+
+    wire        tile_loaded;
+    pixel_tile #(.TILE(TILE)) u_tile (
+        .clk(dma_clk), .rst_n(dma_reset_n), .clear(job_start),
+        .mode(ctrl_rot_mode), .tile_w(rot_lw), .tile_h(rot_lh), .loaded(tile_loaded),
+        .in_data(unpk_data), .in_valid(unpk_valid && run_rot), .in_ready(tile_in_ready),
+        .out_data(tile_data), .out_valid(tile_valid), .out_ready(pipeline_ready[0] && run_rot)
+    );
     
-    // Output FIFO Write Logic
-    // Last Stage가 Valid하고 Output FIFO가 Ready면 쓴다
+    // 2. Stage Output -> pixel_pack (XRGB -> 목적지 Format) -> Output FIFO
+    // pixel_pack이 Byte를 받을 수 있으면 Ready (XRGB면 Output FIFO가 Full이 아닐 때)
+    wire pack_ready;
+    assign pipeline_ready[PIPE_LATENCY] = pack_ready;
+
+    pixel_pack u_pack (
+        .clk(dma_clk), .rst_n(dma_reset_n),
+        .fmt(run_dst_fmt), .clear(job_start),
+        .px_data(pipeline_data[PIPE_LATENCY]), .px_valid(pipeline_valid[PIPE_LATENCY]),
+        .px_ready(pack_ready),
+        .out_data(fifo_out_wr_data), .out_wr(fifo_out_wr_en), .out_full(fifo_out_full)
+    );
+
+    // 3. Pixel ALU
+    localparam [3:0] OP_COEFF = 4'd0, OP_PASS = 4'd1, OP_BRIGHT = 4'd2, OP_GRAY = 4'd3,
+                     OP_SWIZZLE = 4'd4, OP_THRESHOLD = 4'd5, OP_INVERT = 4'd6, OP_ADD_SAT = 4'd7;
+
+    function [7:0] clamp8;
+        input signed [12:0] v;
+        begin
+            if (v < 0)        clamp8 = 8'd0;
+            else if (v > 255) clamp8 = 8'd255;
+            else              clamp8 = v[7:0];
+        end
+    endfunction
+
+    function [7:0] add_sat8;
+        input [7:0] a, b;
+        reg   [8:0] sum;
+        begin
+            sum = a + b;
+            add_sat8 = sum[8] ? 8'hFF : sum[7:0];
+        end
+    endfunction
+
+    localparam [3:0] OP_BLEND = 4'd8, OP_ABSDIFF = 4'd9, OP_MIN = 4'd10, OP_MAX = 4'd11,
+                     OP_ADD2_SAT = 4'd12;
+
+    // Stage 1 부가 레지스터: 채널별 곱 (BRIGHT: (c-128)*Gain, GRAY/THRESHOLD: 휘도 가중치)
+    reg signed [19:0] alu_prod [0:2];    // [0] R, [1] G, [2] B
+    // Dual-Source: B 데이터 (Stage 0, 1), BLEND 곱의 합 (Stage 1)
+    reg [31:0]        pipe_b0, pipe_b1;
+    reg [16:0]        blend_sum [0:2];
+
+    wire [8:0] blend_alpha = (run_pix_param[8:0] > 9'd256) ? 9'd256 : run_pix_param[8:0];
+    wire [8:0] blend_beta  = 9'd256 - blend_alpha;
+
+    function [7:0] absdiff8;
+        input [7:0] a, b;
+        begin
+            absdiff8 = (a > b) ? a - b : b - a;
+        end
+    endfunction
+
+    wire [7:0] p0_r = pipeline_data[0][23:16];
+    wire [7:0] p0_g = pipeline_data[0][15:8];
+    wire [7:0] p0_b = pipeline_data[0][7:0];
+    wire signed [9:0] bright_gain = {1'b0, run_pix_param[8:0]};
+
+    wire [31:0] p1 = pipeline_data[1];
+    wire [15:0] luma_sum = alu_prod[0][15:0] + alu_prod[1][15:0] + alu_prod[2][15:0];
+    wire [7:0]  luma = luma_sum[15:8];
+    wire signed [12:0] bright_bias = 13'sd128 + {{4{run_pix_param[24]}}, run_pix_param[24:16]};
+
+    function [7:0] swz_byte;
+        input [31:0] w;
+        input [1:0]  sel;
+        begin
+            swz_byte = w[sel*8 +: 8];
+        end
+    endfunction
+
+    reg [31:0] alu_out;
     always @(*) begin
-        fifo_out_wr_en = pipeline_valid[PIPE_LATENCY] && pipeline_ready[PIPE_LATENCY];
-        fifo_out_wr_data = pipeline_data[PIPE_LATENCY];
+        case (run_pix_op)
+            OP_COEFF:     alu_out = (p1 * 64'd5243) >> 21;
+            OP_BRIGHT:    alu_out = {p1[31:24],
+                                     clamp8((alu_prod[0] >>> 7) + bright_bias),
+                                     clamp8((alu_prod[1] >>> 7) + bright_bias),
+                                     clamp8((alu_prod[2] >>> 7) + bright_bias)};
+            OP_GRAY:      alu_out = {p1[31:24], luma, luma, luma};
+            OP_SWIZZLE:   alu_out = {swz_byte(p1, run_pix_param[7:6]), swz_byte(p1, run_pix_param[5:4]),
+                                     swz_byte(p1, run_pix_param[3:2]), swz_byte(p1, run_pix_param[1:0])};
+            OP_THRESHOLD: alu_out = {p1[31:24], (luma >= run_pix_param[7:0]) ? 24'hFFFFFF : 24'h000000};
+            OP_INVERT:    alu_out = p1 ^ 32'h00FFFFFF;
+            OP_ADD_SAT:   alu_out = {p1[31:24],
+                                     add_sat8(p1[23:16], run_pix_param[23:16]),
+                                     add_sat8(p1[15:8],  run_pix_param[15:8]),
+                                     add_sat8(p1[7:0],   run_pix_param[7:0])};
+            OP_BLEND:     alu_out = {p1[31:24], blend_sum[0][15:8], blend_sum[1][15:8], blend_sum[2][15:8]};
+            OP_ABSDIFF:   alu_out = {p1[31:24], absdiff8(p1[23:16], pipe_b1[23:16]),
+                                     absdiff8(p1[15:8], pipe_b1[15:8]), absdiff8(p1[7:0], pipe_b1[7:0])};
+            OP_MIN:       alu_out = {p1[31:24],
+                                     (p1[23:16] < pipe_b1[23:16]) ? p1[23:16] : pipe_b1[23:16],
+                                     (p1[15:8]  < pipe_b1[15:8])  ? p1[15:8]  : pipe_b1[15:8],
+                                     (p1[7:0]   < pipe_b1[7:0])   ? p1[7:0]   : pipe_b1[7:0]};
+            OP_MAX:       alu_out = {p1[31:24],
+                                     (p1[23:16] > pipe_b1[23:16]) ? p1[23:16] : pipe_b1[23:16],
+                                     (p1[15:8]  > pipe_b1[15:8])  ? p1[15:8]  : pipe_b1[15:8],
+                                     (p1[7:0]   > pipe_b1[7:0])   ? p1[7:0]   : pipe_b1[7:0]};
+            OP_ADD2_SAT:  alu_out = {p1[31:24], add_sat8(p1[23:16], pipe_b1[23:16]),
+                                     add_sat8(p1[15:8], pipe_b1[15:8]), add_sat8(p1[7:0], pipe_b1[7:0])};
+            default:      alu_out = p1;
+        endcase
     end
 
-    // 3. Pipeline Register Update
+    // 4. Pipeline Register Update
     integer i;
-    always @(posedge clk or negedge reset_n) begin
-        if (!reset_n) begin
+    always @(posedge dma_clk or negedge dma_reset_n) begin
+        if (!dma_reset_n) begin
             for (i = 0; i <= PIPE_LATENCY; i = i + 1) begin
                 pipeline_valid[i] <= 0;
                 pipeline_data[i] <= 0;
             end
+            for (i = 0; i < 3; i = i + 1) begin
+                alu_prod[i] <= 0;
+                blend_sum[i] <= 0;
+            end
+            pipe_b0 <= 0; pipe_b1 <= 0;
         end else begin
             // Stage 0 Update (From FIFO)
             if (pipeline_ready[0]) begin
-                pipeline_valid[0] <= !fifo_in_empty; // Valid if FIFO not empty
-                pipeline_data[0] <= fifo_in_rd_data;
+                pipeline_valid[0] <= in_valid; // Valid if FIFO not empty (Dual: A/B 모두)
+                pipeline_data[0] <= run_scale ? scl_data : run_rot ? tile_data : unpk_data;
+                pipe_b0 <= fifo_b_rd_data;
             end
             
             // Stages 1 to PIPE_LATENCY Update
@@ -233,10 +1257,26 @@ module burst_master_4 #(
                     
                     // Operation Logic
                     if (pipeline_valid[i]) begin
-                        // Stage 0 -> 1: Multiply
-                        if (i == 0) pipeline_data[i+1] <= pipeline_data[i] * ctrl_coeff; 
-                        // Stage 1 -> 2: Multiply
-                        else if (i == 1) pipeline_data[i+1] <= (pipeline_data[i] * 64'd5243) >> 21;                         
+                        // Stage 0 -> 1: Multiply (COEFF) / 채널별 곱
+                        if (i == 0) begin
+                            pipeline_data[i+1] <= (run_pix_op == OP_COEFF) ? pipeline_data[i] * run_coeff
+                                                                           : pipeline_data[i];
+                            if (run_pix_op == OP_BRIGHT) begin
+                                alu_prod[0] <= ($signed({2'b0, p0_r}) - 10'sd128) * bright_gain;
+                                alu_prod[1] <= ($signed({2'b0, p0_g}) - 10'sd128) * bright_gain;
+                                alu_prod[2] <= ($signed({2'b0, p0_b}) - 10'sd128) * bright_gain;
+                            end else begin
+                                alu_prod[0] <= p0_r * 8'd77;
+                                alu_prod[1] <= p0_g * 8'd150;
+                                alu_prod[2] <= p0_b * 8'd29;
+                            end
+                            pipe_b1 <= pipe_b0;
+                            blend_sum[0] <= p0_r * blend_alpha + pipe_b0[23:16] * blend_beta;
+                            blend_sum[1] <= p0_g * blend_alpha + pipe_b0[15:8]  * blend_beta;
+                            blend_sum[2] <= p0_b * blend_alpha + pipe_b0[7:0]   * blend_beta;
+                        end
+                        // Stage 1 -> 2: Pixel ALU 결과
+                        else if (i == 1) pipeline_data[i+1] <= alu_out;
                         else pipeline_data[i+1] <= pipeline_data[i];
                     end else begin
                         pipeline_data[i+1] <= 0; // Optional clear
@@ -252,38 +1292,193 @@ module burst_master_4 #(
     // =========================================================================
     // Write Master FSM
     // =========================================================================
-    assign fifo_out_rd_en = (wm_fsm == W_BURST) && (!wm_waitrequest) && (wm_word_cnt < wm_burstcount);
-    assign wm_writedata = fifo_out_rd_data;
+    wire wr_beat = (wm_fsm == W_BURST) && wm_write && (!wm_waitrequest) && (wm_word_cnt < wm_burstcount);
+    assign fifo_out_rd_en = wr_beat && (run_fill_mode == FILL_OFF);
+    // Cut-through: 다음 클럭에 Output FIFO에 데이터가 남아 있는지 (FWFT, 쓰기 다음 클럭부터 보임)
+    wire out_avail_next = (fifo_out_used + (fifo_out_wr_en ? 1 : 0) - (fifo_out_rd_en ? 1 : 0)) != 0;
+    // Descriptor STATUS Write-back: [31] Done, [30:0] 전송한 Byte 수 (Byteenable로 가린 Byte 제외)
+    wire [31:0] wb_status = {1'b1, wr_bytes_done[30:0]};
 
-    always @(posedge clk or negedge reset_n) begin
-        if (!reset_n) begin
+    // ... BIST Pattern Generator & Comparator ...
+    // 쓰기(FILL_BIST)와 검증은 같은 생성기를 씁니다. 워드마다 한 칸씩 진행하고,
+    // ADDR / WALK / ALT는 워드의 Byte 주소로 정해지므로 어느 쪽에서 세어도 같은 값입니다.
+    reg [31:0] bist_data;
+    always @(*) begin
+        case (ctrl_bist_pat)
+            PAT_ADDR: bist_data = bist_addr ^ ctrl_bist_seed;
+            PAT_WALK: bist_data = (32'h1 << bist_addr[6:2]) ^ ctrl_bist_seed;
+            PAT_LFSR: bist_data = bist_lfsr;
+            default:  bist_data = bist_addr[2] ? ~ctrl_bist_seed : ctrl_bist_seed;
+        endcase
+    end
+
+    wire bist_cmp  = run_bist_verify && unpk_valid;
+    wire bist_step = (wr_beat && run_fill_mode == FILL_BIST) || bist_cmp;
+
+    always @(posedge dma_clk or negedge dma_reset_n) begin
+        if (!dma_reset_n) begin
+            bist_addr <= 0; bist_lfsr <= 1; bist_cmp_left <= 0;
+            bist_err_cnt <= 0; bist_err_addr <= 0; bist_err_data <= 0; bist_err_exp <= 0;
+        end else begin
+            if (dma_start) begin
+                bist_err_cnt <= 0; bist_err_addr <= 0; bist_err_data <= 0; bist_err_exp <= 0;
+            end
+            if (job_start) begin
+                bist_addr <= job_bist_verify ? job_src : job_dst;
+                bist_lfsr <= (ctrl_bist_seed == 0) ? 32'd1 : ctrl_bist_seed;
+                bist_cmp_left <= job_bist_verify ? (job_len >> 2) : 0;
+            end else if (bist_step) begin
+                bist_addr <= bist_addr + 4;
+                // Galois LFSR x^32 + x^22 + x^2 + x + 1
+                bist_lfsr <= (bist_lfsr >> 1) ^ (bist_lfsr[0] ? 32'h80200003 : 32'h0);
+                if (bist_cmp) begin
+                    bist_cmp_left <= bist_cmp_left - 1;
+                    if (unpk_data != bist_data) begin
+                        bist_err_cnt <= bist_err_cnt + 1;
+                        if (bist_err_cnt == 0) begin        // 첫 번째 불일치만 기록
+                            bist_err_addr <= bist_addr;
+                            bist_err_data <= unpk_data;
+                            bist_err_exp <= bist_data;
+                        end
+                    end
+                end
+            end
+        end
+    end
+
+    // ... Fill Generator ...
+    reg [31:0] fill_data;
+    always @(*) begin
+        case (run_fill_mode)
+            FILL_CONST:    fill_data = ctrl_fill_pat[0];
+            FILL_GRADIENT: fill_data = fill_acc;
+            FILL_BIST:     fill_data = bist_data;
+            default:       fill_data = ctrl_fill_pat[fill_idx];
+        endcase
+    end
+
+    // Completion Ring Entry
+    reg [31:0] cpl_data;
+    always @(*) begin
+        case (wm_word_cnt[1:0])
+            2'd0:    cpl_data = cq_cmd;
+            2'd1:    cpl_data = {1'b1, cq_bytes[30:0]};
+            2'd2:    cpl_data = cq_t_start;
+            default: cpl_data = cq_t_end;
+        endcase
+    end
+    wire [ADDR_WIDTH-1:0] cpl_addr = ctrl_cq_ring + ((cq_head & (ctrl_cq_size - 1)) << 4);
+
+    assign wm_writedata = (wm_fsm == W_DESC) ? (wb_cpl ? cpl_data : wb_status) :
+                          (run_fill_mode != FILL_OFF) ? fill_data : fifo_out_rd_data;
+
+    // Byte 단위 길이: 줄의 첫 Word는 Head, 마지막 Word는 Tail Byte만 씀 (한 Word면 둘 다)
+    wire wr_first_word = (remaining_len == run_wr_width) && (wm_word_cnt == 0);
+    wire wr_last_word  = ((remaining_len >> 2) == wm_word_cnt + 1);
+    assign wm_byteenable = (wm_fsm != W_BURST) ? 4'hF :
+                           (wr_first_word ? run_be_head : 4'hF) & (wr_last_word ? run_be_tail : 4'hF);
+    wire [2:0] wr_be_bytes = {2'b0, wm_byteenable[0]} + {2'b0, wm_byteenable[1]} +
+                             {2'b0, wm_byteenable[2]} + {2'b0, wm_byteenable[3]};
+
+    // 줄 시작마다 생성기를 처음으로 되돌림
+    wire wr_line_start = (wm_fsm == W_IDLE && job_start) ||
+                         (wm_fsm == W_WAIT_DATA && remaining_len == 0 && wr_lines_left > 1);
+    wire [2:0] fill_idx_next = (fill_idx == run_fill_last) ? 3'd0 : fill_idx + 1;
+
+    always @(posedge dma_clk or negedge dma_reset_n) begin
+        if (!dma_reset_n) begin
+            fill_idx <= 0; fill_run <= 0; fill_acc <= 0;
+        end else if (wr_line_start) begin
+            fill_idx <= 0; fill_run <= 0; fill_acc <= ctrl_fill_pat[0];
+        end else if (wr_beat) begin
+            fill_acc <= fill_acc + ctrl_fill_pat[1];
+            if (run_fill_mode == FILL_PATTERN) begin
+                fill_idx <= fill_idx_next;
+            end else if (run_fill_mode == FILL_BARS) begin
+                if (fill_run == run_bar_width - 1) begin
+                    fill_run <= 0;
+                    fill_idx <= fill_idx_next;
+                end else begin
+                    fill_run <= fill_run + 1;
+                end
+            end
+        end
+    end
+
+    always @(posedge dma_clk or negedge dma_reset_n) begin
+        if (!dma_reset_n) begin
             wm_fsm <= W_IDLE; wm_write <= 0; wm_word_cnt <= 0; wm_address <= 0;
             current_dst_addr <= 0; remaining_len <= 0; internal_done_pulse <= 0; wm_burstcount <= BURST_COUNT;
+            wr_split_cnt <= 0; wb_done <= 0; wb_cpl <= 0;
+            wr_line_addr <= 0; wr_lines_left <= 0; wr_bytes_done <= 0;
         end else begin
             internal_done_pulse <= 0;
+            wb_done <= 0;
+            if (dma_start) wr_split_cnt <= 0;
             case (wm_fsm)
                 W_IDLE: begin
                     wm_write <= 0;
-                    if (ctrl_start) begin
-                        current_dst_addr <= ctrl_dst_addr;
-                        remaining_len <= ctrl_len;
+                    if (job_start) begin
+                        current_dst_addr <= job_dst;
+                        wr_line_addr <= job_dst;
+                        // 어긋난 Job: 쓸 것 없이 다음 클럭에 Done
+                        remaining_len <= job_misalign ? {ADDR_WIDTH{1'b0}} : job_wr_len;
+                        wr_lines_left <= job_misalign ? 16'd1 : job_wr_height;
+                        wr_bytes_done <= 0;
                         wm_fsm <= W_WAIT_DATA;
+                    end else if (seq_wb_go || seq_cpl_go) begin
+                        // STATUS Word 1개 또는 Completion Entry 4 Word
+                        wm_address <= seq_cpl_go ? cpl_addr : desc_ptr + 4;
+                        wm_burstcount <= seq_cpl_go ? 9'd4 : 9'd1;
+                        wm_word_cnt <= 0;
+                        wb_cpl <= seq_cpl_go;
+                        wm_write <= 1;
+                        wm_fsm <= W_DESC;
+                    end
+                end
+                W_DESC: if (!wm_waitrequest) begin
+                    if (wm_word_cnt == wm_burstcount - 1) begin
+                        wm_write <= 0;
+                        wb_done <= 1;
+                        wm_fsm <= W_IDLE;
+                    end else begin
+                        wm_word_cnt <= wm_word_cnt + 1;
                     end
                 end
                 W_WAIT_DATA: begin
                     wm_write <= 0;
-                    if (remaining_len == 0) begin
-                        internal_done_pulse <= 1;
-                        wm_fsm <= W_IDLE;
-                    end else if (fifo_out_used >= ctrl_wr_burst) begin
+                    if (rot_wr_next) begin
+                        // Rotate: 다음 타일 (Done 없이 이어서 씀)
+                        current_dst_addr <= rot_dst;
+                        wr_line_addr <= rot_dst;
+                        remaining_len <= {rot_dst_tw, 2'b00};
+                        wr_lines_left <= {8'b0, rot_dst_th};
+                    end else if (remaining_len == 0) begin
+                        if (wr_lines_left > 1) begin
+                            // 2D: 다음 줄
+                            current_dst_addr <= wr_line_addr + run_dst_stride;
+                            wr_line_addr <= wr_line_addr + run_dst_stride;
+                            remaining_len <= run_wr_width;
+                            wr_lines_left <= wr_lines_left - 1;
+                        end else if (!rot_wr_hold && (!run_scale || scl_drained) &&
+                                     (!run_bist_verify || bist_cmp_left == 0)) begin
+                            // Resize: 버려지는 소스 줄까지 다 읽어야 끝 (다음 전송에 섞이지 않도록)
+                            // BIST Verify: 쓰기 없이 비교가 끝나기를 기다림
+                            // Rotate: 마지막 타일까지 다 써야 끝
+                            internal_done_pulse <= 1;
+                            wm_fsm <= W_IDLE;
+                        end
+                    end else if (wr_issue) begin
                         wm_address <= current_dst_addr;
-                        wm_burstcount <= ctrl_wr_burst;
+                        wm_burstcount <= wr_next_burst;
+                        if (wr_next_burst != run_wr_burst) wr_split_cnt <= wr_split_cnt + 1;
                         wm_write <= 1; wm_word_cnt <= 0;
                         wm_fsm <= W_BURST;
                     end
                 end
                 W_BURST: begin
-                    if (!wm_waitrequest) begin
+                    if (wr_beat) begin
+                        wr_bytes_done <= wr_bytes_done + wr_be_bytes;
                         if (wm_word_cnt == wm_burstcount - 1) begin
                             wm_write <= 0;
                             current_dst_addr <= current_dst_addr + (wm_burstcount * 4);
@@ -291,22 +1486,287 @@ module burst_master_4 #(
                             wm_fsm <= W_WAIT_DATA;
                         end else begin
                             wm_word_cnt <= wm_word_cnt + 1;
+                            if (run_cut_thru) wm_write <= out_avail_next;
                         end
+                    end else if (!wm_write) begin
+                        // Cut-through: 데이터가 다시 들어오면 이어서 씀
+                        wm_write <= out_avail_next;
+                    end
+                end
+            endcase
+        end
+    end
+
+    // =========================================================================
+    // Descriptor Sequencer (dma_clk domain)
+    // =========================================================================
+    // Fetch (Read Master) -> Execute (Job) -> Write-back (Write Master) -> NEXT
+    // 각 단계 사이에는 두 마스터가 모두 IDLE이므로 *_go 펄스 한 번으로 요청합니다.
+    // Queue 명령은 꺼낸 다음 클럭에 주소를 받고(S_POP), 체인이 끝나면 Completion Entry를 쓴 뒤(S_CPL) 끝납니다.
+    localparam [2:0] S_IDLE = 3'd0, S_FETCH = 3'd1, S_EXEC = 3'd2, S_WB = 3'd3, S_CPL = 3'd4,
+                     S_POP = 3'd5;
+    reg [2:0] seq_state;
+
+    // Queue Pop: 엔진 전체가 비어 있고 Ring에 자리가 있을 때 (CTRL Start와 겹치면 CTRL 우선)
+    wire cq_ring_ok = (ctrl_cq_size == 0) || ((cq_head - run_cq_tail) < ctrl_cq_size);
+    assign cq_pop   = !cq_empty && cq_ring_ok && !dma_start && (seq_state == S_IDLE) &&
+                      (rm_state == IDLE) && (wm_fsm == W_IDLE) && !rot_active;
+
+    // Normal Mode: FWFT로 미리 꺼낸 명령은 wrusedw/wrfull에 잡히지 않아 CQ_STATUS와 Full이 하나씩 어긋남
+    simple_dcfifo #(.DATA_WIDTH(ADDR_WIDTH), .ADDR_WIDTH(CQ_AW), .SHOW_AHEAD(0)) u_cmd_queue (
+        .wrclk(clk), .data(avs_writedata), .wrreq(cq_push), .wrusedw(cq_level), .wrfull(cq_full),
+        .rdclk(dma_clk), .rdreq(cq_pop), .q(cq_q), .rdempty(cq_empty), .rdusedw()
+    );
+    assign cq_push = avs_write && (avs_address == 6'd48) && !cq_full;
+
+    always @(posedge dma_clk or negedge dma_reset_n) begin
+        if (!dma_reset_n) begin
+            seq_state <= S_IDLE; desc_ptr <= 0; desc_cnt <= 0;
+            chain_active <= 0; chain_done <= 0;
+            seq_fetch_go <= 0; seq_job_start <= 0; seq_wb_go <= 0; seq_cpl_go <= 0;
+            cq_active <= 0; cq_cmd <= 0; cq_bytes <= 0; cq_time <= 0;
+            cq_t_start <= 0; cq_t_end <= 0;
+            cq_head <= 0; cq_head_gray <= 0;
+            cq_tail_sync <= 0; run_cq_tail <= 0;
+        end else begin
+            seq_fetch_go <= 0; seq_job_start <= 0; seq_wb_go <= 0; seq_cpl_go <= 0;
+            chain_done <= 0;
+            cq_time <= cq_time + 1;
+            // CQ_TAIL: clk -> dma_clk (Toggle, 값은 Quasi-static)
+            cq_tail_sync <= {cq_tail_sync[1:0], cq_tail_toggle};
+            if (cq_tail_sync[2] ^ cq_tail_sync[1]) run_cq_tail <= ctrl_cq_tail;
+            case (seq_state)
+                S_IDLE: if (dma_start && ctrl_desc_mode) begin
+                    chain_active <= 1;
+                    desc_ptr <= ctrl_desc_addr;
+                    desc_cnt <= 0;
+                    seq_fetch_go <= 1;
+                    seq_state <= S_FETCH;
+                end else if (cq_pop) begin
+                    seq_state <= S_POP;
+                end
+                S_POP: begin
+                    chain_active <= 1;
+                    cq_active <= 1;
+                    desc_ptr <= cq_q;
+                    cq_cmd <= cq_q;
+                    cq_bytes <= 0;
+                    cq_t_start <= cq_time;
+                    desc_cnt <= 0;
+                    seq_fetch_go <= 1;
+                    seq_state <= S_FETCH;
+                end
+                S_FETCH: if (fetch_done) begin
+                    seq_job_start <= 1;
+                    seq_state <= S_EXEC;
+                end
+                S_EXEC: if (internal_done_pulse) begin
+                    seq_wb_go <= 1;
+                    seq_state <= S_WB;
+                end
+                S_WB: if (wb_done) begin
+                    desc_cnt <= desc_cnt + 1;
+                    cq_bytes <= cq_bytes + wr_bytes_done;
+                    if ((desc_word[7][0] || desc_word[0] == 0) && cq_active && ctrl_cq_size != 0) begin
+                        cq_t_end <= cq_time;
+                        seq_cpl_go <= 1;
+                        seq_state <= S_CPL;
+                    end else if (desc_word[7][0] || desc_word[0] == 0) begin
+                        chain_active <= 0;
+                        cq_active <= 0;
+                        chain_done <= 1;
+                        seq_state <= S_IDLE;
+                    end else begin
+                        desc_ptr <= desc_word[0];
+                        seq_fetch_go <= 1;
+                        seq_state <= S_FETCH;
                     end
                 end
+                S_CPL: if (wb_done) begin
+                    chain_active <= 0;
+                    cq_active <= 0;
+                    chain_done <= 1;
+                    cq_head <= cq_head + 1;
+                    cq_head_gray <= (cq_head + 16'd1) ^ ((cq_head + 16'd1) >> 1);
+                    seq_state <= S_IDLE;
+                end
+            endcase
+        end
+    end
+
+    // =========================================================================
+    // Rotate Tile Sequencer (dma_clk domain)
+    // =========================================================================
+    // 소스 사각형 (LEN/4 x HEIGHT)을 TILE x TILE 타일로 나눠 줄 순서로 처리합니다.
+    // 회전 전체가 Job 하나이고(R_EXEC), 타일 좌표는 세 곳이 따로 따라갑니다.
+    // - 읽기 (rot_tx/ty): 타일의 읽기 버스트를 다 냈으면 다음 타일 주소를 줌 (rot_rd_next)
+    // - Load (rot_lx/ly): pixel_tile이 타일 하나를 다 받으면 다음 타일 크기로
+    // - 쓰기 (rot_wx/wy): 타일의 마지막 쓰기 버스트가 끝나면 다음 타일 주소를 줌 (rot_wr_next)
+    // pixel_tile이 Ping-Pong이므로 타일 N을 쓰는 동안 타일 N+1을 읽고 받습니다.
+    // 가장자리 타일은 남은 크기만큼 작아집니다.
+    localparam [1:0] R_IDLE = 2'd0, R_ADDR = 2'd1, R_EXEC = 2'd2;
+    localparam [1:0] T_RUN = 2'd0, T_ADDR = 2'd1, T_LOAD = 2'd2, T_LAST = 2'd3;
+    reg [1:0] rot_state, rot_rd_st, rot_wr_st;
+
+    wire [15:0] rot_w  = ctrl_len[17:2];
+    wire [15:0] rot_h  = (ctrl_height == 0) ? 16'd1 : ctrl_height;
+    // 쓰는 타일의 목적지 좌상단 (픽셀)
+    reg  [15:0] rot_ox, rot_oy;
+    always @(*) begin
+        case (ctrl_rot_mode)
+            ROT_90:        begin rot_ox = rot_h - rot_wy - rot_wh; rot_oy = rot_wx;                  end
+            ROT_180:       begin rot_ox = rot_w - rot_wx - rot_ww; rot_oy = rot_h - rot_wy - rot_wh; end
+            ROT_270:       begin rot_ox = rot_wy;                  rot_oy = rot_w - rot_wx - rot_ww; end
+            ROT_FLIP_H:    begin rot_ox = rot_w - rot_wx - rot_ww; rot_oy = rot_wy;                  end
+            ROT_FLIP_V:    begin rot_ox = rot_wx;                  rot_oy = rot_h - rot_wy - rot_wh; end
+            ROT_TRANSPOSE: begin rot_ox = rot_wy;                  rot_oy = rot_wx;                  end
+            default:       begin rot_ox = rot_wx;                  rot_oy = rot_wy;                  end
+        endcase
+    end
+
+    // 줄 순서로 다음 타일 좌표와 크기
+    function [15:0] tile_next_x;
+        input [15:0] tx;
+        input [7:0]  tw;
+        input [15:0] w;
+        begin
+            tile_next_x = (tx + tw >= w) ? 16'd0 : tx + TILE;
+        end
+    endfunction
+
+    function [15:0] tile_next_y;
+        input [15:0] tx, ty;
+        input [7:0]  tw;
+        input [15:0] w;
+        begin
+            tile_next_y = (tx + tw >= w) ? ty + TILE : ty;
+        end
+    endfunction
+
+    function [7:0] tile_len;
+        input [15:0] pos, size;
+        begin
+            tile_len = (size - pos > TILE) ? TILE : size - pos;
+        end
+    endfunction
+
+    wire [15:0] rot_rd_nx = tile_next_x(rot_tx, rot_tw, rot_w);
+    wire [15:0] rot_rd_ny = tile_next_y(rot_tx, rot_ty, rot_tw, rot_w);
+    wire [15:0] rot_ld_nx = tile_next_x(rot_lx, rot_lw, rot_w);
+    wire [15:0] rot_ld_ny = tile_next_y(rot_lx, rot_ly, rot_lw, rot_w);
+    wire [15:0] rot_wr_nx = tile_next_x(rot_wx, rot_ww, rot_w);
+    wire [15:0] rot_wr_ny = tile_next_y(rot_wx, rot_wy, rot_ww, rot_w);
+    wire        rot_rd_last = (rot_tx + rot_tw >= rot_w) && (rot_ty + rot_th >= rot_h);
+    wire        rot_wr_last = (rot_wx + rot_ww >= rot_w) && (rot_wy + rot_wh >= rot_h);
+
+    // 현재 타일의 읽기 / 쓰기를 다 냄 (2D 마지막 줄까지)
+    wire rot_rd_end = (rot_state == R_EXEC) && (rm_state == WAIT_FIFO) &&
+                      (read_remaining_len == 0) && (rd_lines_left <= 1);
+    wire rot_wr_end = (rot_state == R_EXEC) && (wm_fsm == W_WAIT_DATA) &&
+                      (remaining_len == 0) && (wr_lines_left <= 1);
+    // 쓰기 마스터: 마지막 타일을 다 쓸 때까지 Done을 내지 않음
+    assign rot_wr_hold = run_rot && (!rot_wr_last || rot_wr_st != T_RUN);
+
+    // 타일 주소: 좌표가 바뀐 다음 클럭에 맞음 (T_ADDR / R_ADDR에서 한 클럭 기다림)
+    always @(posedge dma_clk or negedge dma_reset_n) begin
+        if (!dma_reset_n) begin
+            rot_src <= 0; rot_dst <= 0;
+        end else begin
+            rot_src <= ctrl_src_addr + rot_ty * ctrl_src_stride + {rot_tx, 2'b00};
+            rot_dst <= ctrl_dst_addr + rot_oy * ctrl_dst_stride + {rot_ox, 2'b00};
+        end
+    end
+
+    always @(posedge dma_clk or negedge dma_reset_n) begin
+        if (!dma_reset_n) begin
+            rot_state <= R_IDLE; rot_active <= 0; rot_done <= 0; rot_job_start <= 0;
+            rot_rd_st <= T_RUN; rot_wr_st <= T_RUN; rot_rd_next <= 0; rot_wr_next <= 0;
+            rot_tx <= 0; rot_ty <= 0; rot_tw <= 1; rot_th <= 1;
+            rot_lx <= 0; rot_ly <= 0; rot_lw <= 1; rot_lh <= 1;
+            rot_wx <= 0; rot_wy <= 0; rot_ww <= 1; rot_wh <= 1;
+        end else begin
+            rot_job_start <= 0;
+            rot_done <= 0;
+            rot_rd_next <= 0;
+            rot_wr_next <= 0;
+            case (rot_state)
+                R_IDLE: if (dma_start && !ctrl_desc_mode && rot_en) begin
+                    rot_active <= 1;
+                    rot_tx <= 0; rot_ty <= 0; rot_tw <= tile_len(0, rot_w); rot_th <= tile_len(0, rot_h);
+                    rot_lx <= 0; rot_ly <= 0; rot_lw <= tile_len(0, rot_w); rot_lh <= tile_len(0, rot_h);
+                    rot_wx <= 0; rot_wy <= 0; rot_ww <= tile_len(0, rot_w); rot_wh <= tile_len(0, rot_h);
+                    rot_rd_st <= T_RUN; rot_wr_st <= T_RUN;
+                    rot_state <= R_ADDR;
+                end
+                R_ADDR: begin
+                    rot_job_start <= 1;     // 첫 타일: rot_src / rot_dst가 맞는 클럭
+                    rot_state <= R_EXEC;
+                end
+                R_EXEC: if (internal_done_pulse) begin
+                    rot_active <= 0;
+                    rot_done <= 1;
+                    rot_state <= R_IDLE;
+                end
+            endcase
+
+            // 읽기: 마지막 읽기 버스트를 내면 다음 타일로
+            case (rot_rd_st)
+                T_RUN: if (rot_rd_end) begin
+                    if (rot_rd_last) begin
+                        rot_rd_st <= T_LAST;
+                    end else begin
+                        rot_tx <= rot_rd_nx; rot_ty <= rot_rd_ny;
+                        rot_tw <= tile_len(rot_rd_nx, rot_w); rot_th <= tile_len(rot_rd_ny, rot_h);
+                        rot_rd_st <= T_ADDR;
+                    end
+                end
+                T_ADDR: begin
+                    rot_rd_next <= 1;
+                    rot_rd_st <= T_LOAD;
+                end
+                T_LOAD: rot_rd_st <= T_RUN;     // 읽기 마스터가 새 주소를 받는 클럭
+                default: ;
+            endcase
+
+            // Load: pixel_tile이 받을 다음 타일 크기
+            if (tile_loaded) begin
+                rot_lx <= rot_ld_nx; rot_ly <= rot_ld_ny;
+                rot_lw <= tile_len(rot_ld_nx, rot_w); rot_lh <= tile_len(rot_ld_ny, rot_h);
+            end
+
+            // 쓰기: 마지막 쓰기 버스트가 끝나면 다음 타일로 (마지막 타일은 쓰기 마스터가 Done)
+            case (rot_wr_st)
+                T_RUN: if (rot_wr_end && !rot_wr_last) begin
+                    rot_wx <= rot_wr_nx; rot_wy <= rot_wr_ny;
+                    rot_ww <= tile_len(rot_wr_nx, rot_w); rot_wh <= tile_len(rot_wr_ny, rot_h);
+                    rot_wr_st <= T_ADDR;
+                end
+                T_ADDR: begin
+                    rot_wr_next <= 1;
+                    rot_wr_st <= T_LOAD;
+                end
+                T_LOAD: rot_wr_st <= T_RUN;
+                default: ;
             endcase
         end
     end
 
     simple_fifo #(.DATA_WIDTH(DATA_WIDTH), .FIFO_DEPTH(FIFO_DEPTH)) u_fifo_in (
-        .clk(clk), .rst_n(reset_n),
+        .clk(dma_clk), .rst_n(dma_reset_n),
         .wr_en(fifo_in_wr_en), .wr_data(fifo_in_wr_data),
         .rd_en(fifo_in_rd_en), .rd_data(fifo_in_rd_data),
         .full(fifo_in_full), .empty(fifo_in_empty), .used_w(fifo_in_used)
     );
 
+    simple_fifo #(.DATA_WIDTH(DATA_WIDTH), .FIFO_DEPTH(FIFO_DEPTH)) u_fifo_b (
+        .clk(dma_clk), .rst_n(dma_reset_n),
+        .wr_en(fifo_b_wr_en), .wr_data(rm_readdata),
+        .rd_en(fifo_b_rd_en), .rd_data(fifo_b_rd_data),
+        .full(fifo_b_full), .empty(fifo_b_empty), .used_w(fifo_b_used)
+    );
+
     simple_fifo #(.DATA_WIDTH(DATA_WIDTH), .FIFO_DEPTH(FIFO_DEPTH)) u_fifo_out (
-        .clk(clk), .rst_n(reset_n),
+        .clk(dma_clk), .rst_n(dma_reset_n),
         .wr_en(fifo_out_wr_en), .wr_data(fifo_out_wr_data),
         .rd_en(fifo_out_rd_en), .rd_data(fifo_out_rd_data),
         .full(fifo_out_full), .empty(fifo_out_empty), .used_w(fifo_out_used)
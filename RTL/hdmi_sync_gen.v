@@ -34,6 +34,8 @@ module hdmi_sync_gen (
     // Status from DMA (CSR Domain)
     input  wire        dma_busy,
     input  wire        dma_done_in,
+    input  wire [15:0] dma_split_cnt, // Split bursts in the last frame (quasi-static)
+    input  wire        dma_rd_err,    // Read error response in the last frame (quasi-static)
     
     // Control to DMA (CSR Domain)
     output wire        dma_start_out,
@@ -65,6 +67,14 @@ module hdmi_sync_gen (
     reg        hs_d1;
     reg        vs_d1;
 
+    // Pixel Domain Reset: async assert, released two clk_pixel cycles after reset_n
+    reg [1:0] reset_sync_pixel;
+    always @(posedge clk_pixel or negedge reset_n) begin
+        if (!reset_n) reset_sync_pixel <= 2'b0;
+        else reset_sync_pixel <= {reset_sync_pixel[0], 1'b1};
+    end
+    wire pixel_reset_n = reset_sync_pixel[1];
+
     initial begin
         h_cnt = 0;
         v_cnt = 0;
@@ -99,6 +109,7 @@ module hdmi_sync_gen (
             3'd4:    read_data_mux = reg_bitmap_addr;
             3'd5:    read_data_mux = reg_bitmap_data;
             3'd6:    read_data_mux = reg_frame_ptr;
+            3'd7:    read_data_mux = {dma_rd_err, 15'd0, dma_split_cnt};
             default: read_data_mux = 32'd0;
         endcase
     end
@@ -184,8 +195,8 @@ module hdmi_sync_gen (
 
     // Horizontal Counter
     // Horizontal Counter
-    always @(posedge clk_pixel or negedge reset_n) begin
-        if (!reset_n)
+    always @(posedge clk_pixel or negedge pixel_reset_n) begin
+        if (!pixel_reset_n)
             h_cnt <= 12'd0;
         else if (h_cnt == H_TOTAL - 1)
             h_cnt <= 12'd0;
@@ -194,8 +205,8 @@ module hdmi_sync_gen (
     end
 
     // Vertical Counter
-    always @(posedge clk_pixel or negedge reset_n) begin
-        if (!reset_n)
+    always @(posedge clk_pixel or negedge pixel_reset_n) begin
+        if (!pixel_reset_n)
             v_cnt <= 12'd0;
         else if (h_cnt == H_TOTAL - 1) begin
             if (v_cnt == V_TOTAL - 1)
@@ -212,8 +223,8 @@ module hdmi_sync_gen (
 
     // Pipeline Registers for DE and Data synchronization (clk_pixel domain)
 
-    always @(posedge clk_pixel or negedge reset_n) begin
-        if (!reset_n) begin
+    always @(posedge clk_pixel or negedge pixel_reset_n) begin
+        if (!pixel_reset_n) begin
             hdmi_hs <= 1'b1;
             hdmi_vs <= 1'b1;
             hdmi_de <= 1'b0;
@@ -309,8 +320,8 @@ module hdmi_sync_gen (
     end
 
     // Final Output Stage (clk_pixel Domain)
-    always @(posedge clk_pixel or negedge reset_n) begin
-        if (!reset_n) begin
+    always @(posedge clk_pixel or negedge pixel_reset_n) begin
+        if (!pixel_reset_n) begin
             hdmi_d <= 24'h000000;
         end else begin
             if (visible_d1) begin
@@ -0,0 +1,112 @@
+`timescale 1ns/1ps
+
+/*
+ * 모듈명: pixel_pack
+ *
+ * [개요]
+ * XRGB 픽셀 스트림을 목적지 Format의 메모리 Word(32bit) 스트림으로 묶습니다.
+ * burst_master_4의 파이프라인 마지막 Stage와 Output FIFO 사이에 들어갑니다.
+ * Format 번호와 Byte 순서는 pixel_unpack과 같습니다.
+ *   0: XRGB32  1 Pixel -> 1 Word (그대로 통과)
+ *   1: RGB888  4 Pixel -> 3 Word (X Byte 버림)
+ *   2: RGB565  2 Pixel -> 1 Word (하위 비트 버림)
+ *   3: YUYV    2 Pixel -> 1 Word (BT.601 Full Range, U/V는 두 픽셀 평균)
+ *
+ * [구조]
+ * 픽셀마다 4/3/2 Byte를 Byte Buffer 뒤에 붙이고, 4 Byte 이상이 모이면 Word 하나를
+ * Output FIFO에 씁니다. YUYV는 첫 픽셀의 Y/U/V를 잡아두었다가 두 번째 픽셀에서
+ * 4 Byte를 한꺼번에 붙입니다.
+ * - Throughput: 1 Pixel per Clock
+ * - 남는 Byte가 없도록 픽셀 수는 4의 배수여야 합니다 (burst_master_4가 올림).
+ */
+
+module pixel_pack (
+    input  wire        clk,
+    input  wire        rst_n,
+    input  wire [1:0]  fmt,
+    input  wire        clear,
+
+    // Pixel Input (XRGB)
+    input  wire [31:0] px_data,
+    input  wire        px_valid,
+    output wire        px_ready,
+
+    // Word Output (FIFO Write)
+    output wire [31:0] out_data,
+    output wire        out_wr,
+    input  wire        out_full
+);
+
+    localparam [1:0] F_XRGB = 2'd0, F_RGB888 = 2'd1, F_RGB565 = 2'd2, F_YUYV = 2'd3;
+
+    reg [55:0] byte_buf;
+    reg [3:0]  byte_cnt;
+    reg        yuv_odd;         // 첫 픽셀을 받아둔 상태
+    reg [7:0]  yuv_y0;
+    reg [8:0]  yuv_u0, yuv_v0;
+
+    assign out_wr   = (byte_cnt >= 4'd4) && !out_full && !clear;
+    assign out_data = byte_buf[31:0];
+
+    wire [3:0] left = byte_cnt - (out_wr ? 4'd4 : 4'd0);
+    assign px_ready = (left <= 4'd3) && !clear;
+    wire       px_take = px_valid && px_ready;
+
+    // ... RGB -> YUV (Full Range) ...
+    wire [7:0] r = px_data[23:16];
+    wire [7:0] g = px_data[15:8];
+    wire [7:0] b = px_data[7:0];
+    wire [15:0]       y_sum = r * 8'd77 + g * 8'd150 + b * 8'd29;
+    wire signed [17:0] u_sum = -($signed({10'b0, r}) * 18'sd43) - $signed({10'b0, g}) * 18'sd85
+                               + $signed({10'b0, b}) * 18'sd128;
+    wire signed [17:0] v_sum = $signed({10'b0, r}) * 18'sd128 - $signed({10'b0, g}) * 18'sd107
+                               - $signed({10'b0, b}) * 18'sd21;
+    wire [7:0] y_px = y_sum[15:8];
+    wire [8:0] u_px = (u_sum >>> 8) + 9'sd128;   // 0~255
+    wire [8:0] v_px = (v_sum >>> 8) + 9'sd128;
+    wire [8:0] u_avg = (yuv_u0 + u_px) >> 1;
+    wire [8:0] v_avg = (yuv_v0 + v_px) >> 1;
+
+    // 이번 픽셀이 붙이는 Byte 수와 값
+    reg [3:0]  add_cnt;
+    reg [31:0] add_bytes;
+    always @(*) begin
+        case (fmt)
+            F_RGB888: begin add_cnt = 4'd3; add_bytes = {8'h00, px_data[23:0]}; end
+            F_RGB565: begin add_cnt = 4'd2; add_bytes = {16'h0000, r[7:3], g[7:2], b[7:3]}; end
+            F_YUYV:   begin
+                // 첫 픽셀은 붙이지 않음 (byte_buf에 OR되므로 0이어야 함)
+                add_cnt   = yuv_odd ? 4'd4 : 4'd0;
+                add_bytes = yuv_odd ? {v_avg[7:0], y_px, u_avg[7:0], yuv_y0} : 32'd0;
+            end
+            default:  begin add_cnt = 4'd4; add_bytes = px_data; end
+        endcase
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            byte_buf <= 0; byte_cnt <= 0;
+            yuv_odd <= 0; yuv_y0 <= 0; yuv_u0 <= 0; yuv_v0 <= 0;
+        end else if (clear) begin
+            byte_buf <= 0; byte_cnt <= 0;
+            yuv_odd <= 0;
+        end else begin
+            if (px_take && fmt == F_YUYV) begin
+                yuv_odd <= !yuv_odd;
+                if (!yuv_odd) begin
+                    yuv_y0 <= y_px;
+                    yuv_u0 <= u_px;
+                    yuv_v0 <= v_px;
+                end
+            end
+
+            // 쓴 Word를 밀어내고 새 Byte를 뒤에 붙임
+            if (px_take)
+                byte_buf <= (byte_buf >> (out_wr ? 32 : 0)) | ({24'b0, add_bytes} << (left * 8));
+            else
+                byte_buf <= byte_buf >> (out_wr ? 32 : 0);
+            byte_cnt <= left + (px_take ? add_cnt : 4'd0);
+        end
+    end
+
+endmodule
@@ -0,0 +1,235 @@
+`timescale 1ns/1ps
+
+/*
+ * 모듈명: pixel_scaler
+ *
+ * [개요]
+ * XRGB 픽셀 스트림(소스 사각형, 줄 단위)을 받아 Bilinear 필터로 크기를 바꾼
+ * 픽셀 스트림(목적지 사각형)을 만듭니다. burst_master_4의 pixel_unpack과
+ * 파이프라인 Stage 0 사이에 들어가 DDR-to-DDR Resize를 합니다.
+ *
+ * [좌표]
+ * 목적지 픽셀 (i, j)의 소스 좌표 = (i * step_x, j * step_y), 16.16 고정소수점 (좌상단 기준)
+ *   step = (소스 크기 << 16) / 목적지 크기 (소프트웨어가 계산)
+ * 소수부 상위 8bit로 보간하고, 마지막 열/줄을 넘어가면 가장자리 픽셀을 씁니다.
+ * (x+1 / y+1은 src_w-1 / src_h-1에서 멈춤) 소스는 가로/세로 2픽셀 이상이어야 합니다.
+ *
+ * [줄 길이]
+ * src_w는 실제 소스 가로 픽셀 수, line_w는 들어오는 한 줄의 픽셀 수입니다.
+ * Format 변환 시 pixel_unpack은 4 픽셀 단위로 올려 읽으므로 line_w >= src_w이고,
+ * src_w 뒤의 채움 픽셀은 Line Buffer에 쓰지 않고 버립니다.
+ *
+ * [Line Buffer]
+ * - 소스 줄 2개를 M10K에 담습니다. 줄 r은 lb[r & 1]에 저장됩니다.
+ * - 각 Entry는 {px[x+1], px[x]} 두 픽셀을 담아 한 번 읽기로 가로 이웃을 얻습니다.
+ *   (px[x+1]이 들어올 때 Entry x를 씁니다)
+ * - 줄 r은 현재 목적지 줄이 쓰는 위쪽 줄(y0) + 1 이하일 때만 받습니다.
+ *   그래서 보간 중인 두 줄은 덮어쓰지 않고, 축소 시 필요 없는 줄은 그냥 지나갑니다.
+ * - 목적지 줄을 다 만든 뒤 남은 소스 픽셀은 버립니다 (읽기 마스터가 끝까지 가도록).
+ *
+ * [Pipeline]
+ * 주소 -> Line Buffer 읽기 -> 가로 보간 -> 세로 보간 -> 출력 FIFO (Latency 3)
+ * 출력 FIFO에 자리가 있을 때만 픽셀을 만들므로 Back Pressure를 그대로 받습니다.
+ */
+
+module pixel_scaler #(
+    parameter MAX_WIDTH = 2048          // 소스 최대 가로 픽셀 수
+)(
+    input  wire        clk,
+    input  wire        rst_n,
+    input  wire        clear,           // 전송 시작
+    input  wire [15:0] src_w,
+    input  wire [15:0] line_w,          // 입력 줄 픽셀 수 (>= src_w)
+    input  wire [15:0] src_h,
+    input  wire [15:0] dst_w,
+    input  wire [15:0] dst_h,
+    input  wire [31:0] step_x,          // 16.16
+    input  wire [31:0] step_y,          // 16.16
+
+    // Pixel Input (소스, 줄 순서)
+    input  wire [31:0] in_data,
+    input  wire        in_valid,
+    output wire        in_ready,
+
+    // Pixel Output (목적지, 줄 순서)
+    output wire [31:0] out_data,
+    output wire        out_valid,
+    input  wire        out_ready,
+
+    output wire        drained          // 소스 픽셀을 모두 받음
+);
+
+    localparam AW = $clog2(MAX_WIDTH);
+
+    // =========================================================================
+    // 1. 목적지 줄 좌표
+    // =========================================================================
+    reg  [31:0] sy;                     // 현재 목적지 줄의 소스 Y (16.16)
+    reg  [15:0] dst_row;
+    wire        gen_done = (dst_row == dst_h);
+
+    // 위쪽 줄 y0 (마지막 줄을 넘으면 src_h-2 / 가중치 256)
+    wire [15:0] sy_int = sy[31:16];
+    wire        y_edge = (sy_int >= src_h - 1);
+    wire [15:0] y0     = y_edge ? src_h - 2 : sy_int;
+    wire [8:0]  fy     = y_edge ? 9'd256 : {1'b0, sy[15:8]};
+
+    // =========================================================================
+    // 2. Line Buffer 쓰기 (소스 입력)
+    // =========================================================================
+    reg [63:0] lb0 [0:MAX_WIDTH-1];
+    reg [63:0] lb1 [0:MAX_WIDTH-1];
+
+    reg [15:0] in_x, in_row;
+    reg [31:0] in_prev;
+
+    assign drained  = (in_row == src_h);
+    assign in_ready = !clear && !drained && (gen_done || in_row <= y0 + 1);
+    wire   in_take  = in_valid && in_ready;
+    // Entry x = {px[x+1], px[x]}: x+1 <= src_w-1까지만 씀 (채움 픽셀은 버림)
+    wire   lb_we    = in_take && (in_x != 0) && (in_x < src_w) && !gen_done;
+
+    always @(posedge clk) begin
+        if (lb_we && !in_row[0]) lb0[in_x - 1] <= {in_data, in_prev};
+        if (lb_we &&  in_row[0]) lb1[in_x - 1] <= {in_data, in_prev};
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            in_x <= 0; in_row <= 0; in_prev <= 0;
+        end else if (clear) begin
+            in_x <= 0; in_row <= 0;
+        end else if (in_take) begin
+            in_prev <= in_data;
+            if (in_x == line_w - 1) begin
+                in_x <= 0;
+                in_row <= in_row + 1;
+            end else begin
+                in_x <= in_x + 1;
+            end
+        end
+    end
+
+    // =========================================================================
+    // 3. 픽셀 생성
+    // =========================================================================
+    reg  [31:0] sx;
+    reg  [15:0] dst_col;
+    reg         row_active;
+
+    // x+1 Clamp: x0 <= src_w-2이므로 Entry x0의 오른쪽 픽셀은 src_w-1을 넘지 않음
+    wire [15:0] sx_int = sx[31:16];
+    wire        x_edge = (sx_int >= src_w - 1);
+    wire [15:0] x0     = x_edge ? src_w - 2 : sx_int;
+    wire [8:0]  fx     = x_edge ? 9'd256 : {1'b0, sx[15:8]};
+
+    // 두 줄이 모두 Line Buffer에 있어야 시작
+    wire        rows_ready = (in_row >= y0 + 2);
+
+    // 출력 FIFO Credit: 이미 들어있는 것 + 파이프라인 안의 것
+    wire [4:0]  ofifo_used;
+    reg  [1:0]  inflight;
+    wire        credit = (ofifo_used + inflight) < 5'd12;
+
+    wire        issue = row_active && credit;
+
+    // Stage A: Line Buffer 읽기 (M10K Registered Read)
+    reg  [63:0] rd0_q, rd1_q;
+    reg         a_valid, a_top_is_lb1;
+    reg  [8:0]  a_fx, a_fy;
+    always @(posedge clk) begin
+        rd0_q <= lb0[x0[AW-1:0]];
+        rd1_q <= lb1[x0[AW-1:0]];
+    end
+
+    // 위쪽 줄 y0가 들어있는 버퍼 선택
+    wire [63:0] top = a_top_is_lb1 ? rd1_q : rd0_q;
+    wire [63:0] bot = a_top_is_lb1 ? rd0_q : rd1_q;
+
+    function [7:0] lerp8;
+        input [7:0] a, b;
+        input [8:0] f;                  // 0~256
+        reg signed [18:0] d;
+        begin
+            d = ($signed({11'b0, b}) - $signed({11'b0, a})) * $signed({10'b0, f});
+            lerp8 = a + (d >>> 8);
+        end
+    endfunction
+
+    function [31:0] lerp32;
+        input [31:0] a, b;
+        input [8:0]  f;
+        begin
+            lerp32 = {lerp8(a[31:24], b[31:24], f), lerp8(a[23:16], b[23:16], f),
+                      lerp8(a[15:8],  b[15:8],  f), lerp8(a[7:0],   b[7:0],   f)};
+        end
+    endfunction
+
+    // Stage B: 가로 보간, Stage C: 세로 보간
+    reg [31:0] b_top, b_bot, c_px;
+    reg [8:0]  b_fy;
+    reg        b_valid, c_valid;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            sy <= 0; dst_row <= 0; sx <= 0; dst_col <= 0; row_active <= 0;
+            a_valid <= 0; a_top_is_lb1 <= 0; a_fx <= 0; a_fy <= 0;
+            b_valid <= 0; b_top <= 0; b_bot <= 0; b_fy <= 0;
+            c_valid <= 0; c_px <= 0;
+            inflight <= 0;
+        end else if (clear) begin
+            sy <= 0; dst_row <= 0; sx <= 0; dst_col <= 0; row_active <= 0;
+            a_valid <= 0; b_valid <= 0; c_valid <= 0;
+            inflight <= 0;
+        end else begin
+            // 줄 시작: 필요한 두 소스 줄이 준비될 때까지 대기
+            if (!row_active && !gen_done && rows_ready) begin
+                row_active <= 1;
+                sx <= 0;
+                dst_col <= 0;
+            end
+
+            // Stage A
+            a_valid <= issue;
+            if (issue) begin
+                a_top_is_lb1 <= y0[0];
+                a_fx <= fx;
+                a_fy <= fy;
+                sx <= sx + step_x;
+                dst_col <= dst_col + 1;
+                if (dst_col == dst_w - 1) begin
+                    row_active <= 0;
+                    sy <= sy + step_y;
+                    dst_row <= dst_row + 1;
+                end
+            end
+
+            // Stage B
+            b_valid <= a_valid;
+            b_top <= lerp32(top[31:0], top[63:32], a_fx);
+            b_bot <= lerp32(bot[31:0], bot[63:32], a_fx);
+            b_fy  <= a_fy;
+
+            // Stage C
+            c_valid <= b_valid;
+            c_px <= lerp32(b_top, b_bot, b_fy);
+
+            inflight <= inflight + (issue ? 2'd1 : 2'd0) - (c_valid ? 2'd1 : 2'd0);
+        end
+    end
+
+    // =========================================================================
+    // 4. 출력 FIFO
+    // =========================================================================
+    wire ofifo_empty, ofifo_full;
+    assign out_valid = !ofifo_empty;
+
+    // 앞 전송의 픽셀은 쓰기 마스터가 모두 가져가므로 clear 시 비어 있음
+    simple_fifo #(.DATA_WIDTH(32), .FIFO_DEPTH(16)) u_out_fifo (
+        .clk(clk), .rst_n(rst_n),
+        .wr_en(c_valid), .wr_data(c_px),
+        .rd_en(out_ready && !ofifo_empty), .rd_data(out_data),
+        .full(ofifo_full), .empty(ofifo_empty), .used_w(ofifo_used)
+    );
+
+endmodule
@@ -0,0 +1,158 @@
+`timescale 1ns/1ps
+
+/*
+ * 모듈명: pixel_tile
+ *
+ * [개요]
+ * XRGB 픽셀 타일(최대 TILE x TILE, 줄 순서)을 M10K에 받은 뒤 회전/뒤집기한 순서로
+ * 내보냅니다. burst_master_4의 pixel_unpack과 파이프라인 Stage 0 사이에 들어가
+ * 프레임 회전을 타일 단위 전송으로 나눠 처리합니다.
+ *
+ * [Mode] (소스 w x h -> 목적지 dw x dh)
+ *   1: ROT90   시계 방향 90도   dw = h, dh = w
+ *   2: ROT180  180도
+ *   3: ROT270  시계 방향 270도  dw = h, dh = w
+ *   4: FLIP_H  좌우 뒤집기
+ *   5: FLIP_V  상하 뒤집기
+ *   6: TRANSPOSE 대각선 뒤집기  dw = h, dh = w
+ *
+ * [구조] Ping-Pong (타일 버퍼 2개)
+ * - Load: 타일 픽셀을 {bank, y, x} 주소에 씁니다. 크기는 tile_w/tile_h (지금 받는 타일)이고,
+ *   마지막 픽셀을 받으면 그 Bank를 Full로 표시하고 크기를 Bank별로 저장한 뒤 다른 Bank로 넘어갑니다.
+ *   (loaded 1 클럭, 다음 타일 크기로 바꾸라는 신호)
+ * - Emit: Full인 Bank를 저장한 크기로, 목적지 순서 (u, v)마다 소스 좌표 (x, y)를 계산해 읽습니다.
+ *   읽기 레지스터가 그대로 출력 레지스터이므로 출력이 비거나 소비될 때만 읽습니다.
+ *   다 내보내면 Bank를 비우고 다른 Bank로 넘어갑니다.
+ * - 타일 N을 내보내는 동안 타일 N+1을 받으므로 타일 하나에 tile_w x tile_h 클럭입니다.
+ *   (16x16 타일이면 256 클럭, Load와 Emit이 번갈아 하던 때의 절반)
+ * - RAM은 쓰기 포트 하나(Load), 읽기 포트 하나(Emit)인 Simple Dual-Port입니다. (2 x TILE x TILE Word)
+ */
+
+module pixel_tile #(
+    parameter TILE = 16                     // 2의 거듭제곱
+)(
+    input  wire           clk,
+    input  wire           rst_n,
+    input  wire           clear,            // 전송 시작 (두 Bank 모두 비움)
+    input  wire [2:0]     mode,
+    input  wire [7:0]     tile_w,           // 지금 받는 타일 크기, 1 ~ TILE
+    input  wire [7:0]     tile_h,
+    output wire           loaded,           // 타일 하나를 다 받음 (1 클럭)
+
+    // Pixel Input (소스 타일, 줄 순서)
+    input  wire [31:0]    in_data,
+    input  wire           in_valid,
+    output wire           in_ready,
+
+    // Pixel Output (목적지 타일, 줄 순서)
+    output reg  [31:0]    out_data,
+    output reg            out_valid,
+    input  wire           out_ready
+);
+
+    localparam TW = $clog2(TILE);
+    localparam [2:0] M_ROT90 = 3'd1, M_ROT180 = 3'd2, M_ROT270 = 3'd3,
+                     M_FLIP_H = 3'd4, M_FLIP_V = 3'd5, M_TRANSPOSE = 3'd6;
+
+    reg [31:0] tile_ram [0:2*TILE*TILE-1];
+
+    reg [1:0]    full;                      // Bank별: 다 받았고 아직 다 내보내지 않음
+    reg          ld_bank, em_bank;
+    reg [7:0]    bank_w [0:1];
+    reg [7:0]    bank_h [0:1];
+    reg [TW-1:0] in_x, in_y;
+    reg [TW-1:0] out_u, out_v;
+
+    // 내보내는 타일 크기 (소스 / 목적지)
+    wire [7:0]    em_w  = bank_w[em_bank];
+    wire [7:0]    em_h  = bank_h[em_bank];
+    wire          swap  = (mode == M_ROT90) || (mode == M_ROT270) || (mode == M_TRANSPOSE);
+    wire [7:0]    dst_w = swap ? em_h : em_w;
+    wire [7:0]    dst_h = swap ? em_w : em_h;
+
+    // ... Load ...
+    assign in_ready = !clear && !full[ld_bank];
+    wire   in_take  = in_valid && in_ready;
+    wire   in_last  = (in_x == tile_w - 1) && (in_y == tile_h - 1);
+    assign loaded   = in_take && in_last;
+
+    always @(posedge clk) begin
+        if (in_take) tile_ram[{ld_bank, in_y, in_x}] <= in_data;
+    end
+
+    // ... Emit: 목적지 (u, v) -> 소스 (x, y) ...
+    reg [TW-1:0] src_x, src_y;
+    always @(*) begin
+        case (mode)
+            M_ROT90:     begin src_x = out_v;            src_y = em_h - 1 - out_u; end
+            M_ROT180:    begin src_x = em_w - 1 - out_u; src_y = em_h - 1 - out_v; end
+            M_ROT270:    begin src_x = em_w - 1 - out_v; src_y = out_u;            end
+            M_FLIP_H:    begin src_x = em_w - 1 - out_u; src_y = out_v;            end
+            M_FLIP_V:    begin src_x = out_u;            src_y = em_h - 1 - out_v; end
+            M_TRANSPOSE: begin src_x = out_v;            src_y = out_u;            end
+            default:     begin src_x = out_u;            src_y = out_v;            end
+        endcase
+    end
+
+    wire out_free = !out_valid || out_ready;
+    wire emit     = full[em_bank] && out_free && !clear;
+    wire out_last = (out_u == dst_w - 1) && (out_v == dst_h - 1);
+
+    // M10K Registered Read (Clock Enable = emit)
+    always @(posedge clk) begin
+        if (emit) out_data <= tile_ram[{em_bank, src_y, src_x}];
+    end
+
+    always @(posedge clk) begin
+        if (loaded) begin
+            bank_w[ld_bank] <= tile_w;
+            bank_h[ld_bank] <= tile_h;
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            full <= 0; ld_bank <= 0; em_bank <= 0;
+            in_x <= 0; in_y <= 0; out_u <= 0; out_v <= 0;
+            out_valid <= 0;
+        end else if (clear) begin
+            full <= 0; ld_bank <= 0; em_bank <= 0;
+            in_x <= 0; in_y <= 0; out_u <= 0; out_v <= 0;
+            out_valid <= 0;
+        end else begin
+            // 같은 클럭에 한 Bank는 채우고 다른 Bank는 비울 수 있음
+            full <= (full | (loaded ? (2'b01 << ld_bank) : 2'b00))
+                        & ~((emit && out_last) ? (2'b01 << em_bank) : 2'b00);
+
+            if (in_take) begin
+                if (in_x == tile_w - 1) begin
+                    in_x <= 0;
+                    in_y <= in_y + 1;
+                end else begin
+                    in_x <= in_x + 1;
+                end
+                if (in_last) begin
+                    in_y <= 0;
+                    ld_bank <= !ld_bank;
+                end
+            end
+
+            if (emit) begin
+                out_valid <= 1;
+                if (out_u == dst_w - 1) begin
+                    out_u <= 0;
+                    out_v <= out_v + 1;
+                end else begin
+                    out_u <= out_u + 1;
+                end
+                if (out_last) begin
+                    out_v <= 0;
+                    em_bank <= !em_bank;
+                end
+            end else if (out_ready) begin
+                out_valid <= 0;
+            end
+        end
+    end
+
+endmodule
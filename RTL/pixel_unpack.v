@@ -0,0 +1,132 @@
+`timescale 1ns/1ps
+
+/*
+ * 모듈명: pixel_unpack
+ *
+ * [개요]
+ * 메모리 Word(32bit) 스트림을 XRGB 픽셀(1 Pixel = 1 Word) 스트림으로 풉니다.
+ * burst_master_4의 Input FIFO와 파이프라인 Stage 0 사이에 들어갑니다.
+ *
+ * [Format] (메모리 Byte 순서, Little Endian)
+ *   0: XRGB32  B G R X              1 Word -> 1 Pixel (그대로 통과)
+ *   1: RGB888  B G R | B G R ...    3 Word -> 4 Pixel
+ *   2: RGB565  [4:0] B, [10:5] G, [15:11] R     1 Word -> 2 Pixel
+ *   3: YUYV    Y0 U Y1 V            1 Word -> 2 Pixel (BT.601 Full Range)
+ *
+ * [구조]
+ * 최대 7 Byte를 담는 Byte Buffer에 Word를 채우고, 픽셀 하나 분량(4/3/2 Byte)이
+ * 모이면 출력 레지스터로 내보냅니다. YUYV는 4 Byte로 2 픽셀을 만들므로 두 번째
+ * 픽셀을 yuv_px1에 잡아두고 다음 클럭에 내보냅니다.
+ * - Throughput: 1 Pixel per Clock
+ * - 출력은 Valid-Ready Handshake (px_valid && px_ready일 때 소비)
+ * - in_valid/in_rd는 FWFT FIFO에 바로 연결합니다.
+ * - clear: 전송 시작 시 남은 Byte를 버립니다.
+ */
+
+module pixel_unpack (
+    input  wire        clk,
+    input  wire        rst_n,
+    input  wire [1:0]  fmt,
+    input  wire        clear,
+
+    // Word Input (FWFT FIFO)
+    input  wire [31:0] in_data,
+    input  wire        in_valid,
+    output wire        in_rd,
+
+    // Pixel Output (XRGB)
+    output reg  [31:0] px_data,
+    output reg         px_valid,
+    input  wire        px_ready
+);
+
+    localparam [1:0] F_XRGB = 2'd0, F_RGB888 = 2'd1, F_RGB565 = 2'd2, F_YUYV = 2'd3;
+
+    reg [55:0] byte_buf;
+    reg [3:0]  byte_cnt;
+    reg        yuv_hold;        // yuv_px1이 출력 대기 중
+    reg [31:0] yuv_px1;
+
+    // 픽셀 하나에 필요한 Byte 수 (YUYV는 2 픽셀에 4 Byte)
+    wire [3:0] need = (fmt == F_RGB888) ? 4'd3 : (fmt == F_RGB565) ? 4'd2 : 4'd4;
+
+    wire       out_free = !px_valid || px_ready;
+    wire       emit_buf = out_free && !yuv_hold && (byte_cnt >= need);
+    wire [3:0] consume  = emit_buf ? need : 4'd0;
+    wire [3:0] left     = byte_cnt - consume;
+    assign in_rd = in_valid && !clear && (left <= 4'd3);
+
+    // ... YUV -> RGB (Full Range) ...
+    // R = Y + 1.402 V', G = Y - 0.344 U' - 0.714 V', B = Y + 1.772 U'  (x256 고정소수점)
+    function [7:0] clamp8;
+        input signed [11:0] v;
+        begin
+            if (v < 0)        clamp8 = 8'd0;
+            else if (v > 255) clamp8 = 8'd255;
+            else              clamp8 = v[7:0];
+        end
+    endfunction
+
+    function [31:0] yuv2rgb;
+        input [7:0] y, u, v;
+        reg signed [9:0]  du, dv;
+        reg signed [19:0] r, g, b;
+        begin
+            du = $signed({2'b0, u}) - 10'sd128;
+            dv = $signed({2'b0, v}) - 10'sd128;
+            r = ($signed({12'b0, y}) <<< 8) + dv * 10'sd359;
+            g = ($signed({12'b0, y}) <<< 8) - du * 10'sd88 - dv * 10'sd183;
+            b = ($signed({12'b0, y}) <<< 8) + du * 10'sd454;
+            yuv2rgb = {8'h00, clamp8(r >>> 8), clamp8(g >>> 8), clamp8(b >>> 8)};
+        end
+    endfunction
+
+    // ... Byte Buffer -> Pixel ...
+    reg [31:0] px_next;
+    always @(*) begin
+        case (fmt)
+            F_RGB888: px_next = {8'h00, byte_buf[23:0]};
+            F_RGB565: px_next = {8'h00,
+                                 byte_buf[15:11], byte_buf[15:13],
+                                 byte_buf[10:5],  byte_buf[10:9],
+                                 byte_buf[4:0],   byte_buf[4:2]};
+            F_YUYV:   px_next = yuv2rgb(byte_buf[7:0], byte_buf[15:8], byte_buf[31:24]);
+            default:  px_next = byte_buf[31:0];
+        endcase
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            byte_buf <= 0; byte_cnt <= 0;
+            yuv_hold <= 0; yuv_px1 <= 0;
+            px_data <= 0; px_valid <= 0;
+        end else if (clear) begin
+            byte_buf <= 0; byte_cnt <= 0;
+            yuv_hold <= 0;
+            px_valid <= 0;
+        end else begin
+            if (px_valid && px_ready) px_valid <= 0;
+
+            if (out_free && yuv_hold) begin
+                px_data <= yuv_px1;
+                px_valid <= 1;
+                yuv_hold <= 0;
+            end else if (emit_buf) begin
+                px_data <= px_next;
+                px_valid <= 1;
+                if (fmt == F_YUYV) begin
+                    yuv_px1 <= yuv2rgb(byte_buf[23:16], byte_buf[15:8], byte_buf[31:24]);
+                    yuv_hold <= 1;
+                end
+            end
+
+            // 소비한 Byte를 밀어내고 새 Word를 뒤에 붙임
+            if (in_rd)
+                byte_buf <= (byte_buf >> (consume * 8)) | ({24'b0, in_data} << (left * 8));
+            else
+                byte_buf <= byte_buf >> (consume * 8);
+            byte_cnt <= left + (in_rd ? 4'd4 : 4'd0);
+        end
+    end
+
+endmodule
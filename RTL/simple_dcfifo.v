@@ -1,32 +1,53 @@
 `timescale 1ns/1ps
 
+// Simple Dual-Clock FIFO (Verilog Only)
+//
+// - DATA_WIDTH    : Write-side width
+// - RD_DATA_WIDTH : Read-side width. DATA_WIDTH must be RD_DATA_WIDTH * 2^n
+//                   (e.g. 64->32, 128->32). The least significant lane of each
+//                   write word is read first (little endian, same as memory order).
+// - SHOW_AHEAD    : 0 = Normal mode (q valid 1 cycle after rdreq)
+//                   1 = FWFT mode  (q valid whenever !rdempty, rdreq = acknowledge)
+//
+// wrusedw counts write-side words (a partially read word is still "used"),
+// rdusedw counts read-side words (including the FWFT output register).
+
 module simple_dcfifo #(
-    parameter DATA_WIDTH = 32,
-    parameter ADDR_WIDTH = 9  // 512 depth
+    parameter DATA_WIDTH    = 32,
+    parameter ADDR_WIDTH    = 9,  // 512 depth (write-side words)
+    parameter RD_DATA_WIDTH = DATA_WIDTH,
+    parameter SHOW_AHEAD    = 0,
+    // Derived (do not override)
+    parameter RD_ADDR_WIDTH = ADDR_WIDTH + $clog2(DATA_WIDTH / RD_DATA_WIDTH)
 )(
-    input  wire                  wrclk,
-    input  wire [DATA_WIDTH-1:0] data,
-    input  wire                  wrreq,
-    output wire [ADDR_WIDTH-1:0] wrusedw,
-    output wire                  wrfull,
-    
-    input  wire                  rdclk,
-    input  wire                  rdreq,
-    output reg  [DATA_WIDTH-1:0] q,
-    output wire                  rdempty
+    input  wire                     wrclk,
+    input  wire [DATA_WIDTH-1:0]    data,
+    input  wire                     wrreq,
+    output wire [ADDR_WIDTH-1:0]    wrusedw,
+    output wire                     wrfull,
+
+    input  wire                     rdclk,
+    input  wire                     rdreq,
+    output wire [RD_DATA_WIDTH-1:0] q,
+    output wire                     rdempty,
+    output wire [RD_ADDR_WIDTH-1:0] rdusedw
 );
 
+    localparam RATIO      = DATA_WIDTH / RD_DATA_WIDTH;
+    localparam RATIO_LOG2 = RD_ADDR_WIDTH - ADDR_WIDTH;
+
     // ----------------------------------------------------------------
     // 1. Pointers & CDC
     // ----------------------------------------------------------------
     // Pointers are ADDR_WIDTH+1 bits to distinguish Full/Empty
-    reg [ADDR_WIDTH:0] wr_ptr_bin;
-    reg [ADDR_WIDTH:0] wr_ptr_gray;
-    reg [ADDR_WIDTH:0] rd_ptr_bin;
-    reg [ADDR_WIDTH:0] rd_ptr_gray;
+    // Read pointer counts read-side words (RD_ADDR_WIDTH+1 bits)
+    reg [ADDR_WIDTH:0]    wr_ptr_bin;
+    reg [ADDR_WIDTH:0]    wr_ptr_gray;
+    reg [RD_ADDR_WIDTH:0] rd_ptr_bin;
+    reg [RD_ADDR_WIDTH:0] rd_ptr_gray;
 
-    reg [ADDR_WIDTH:0] wr_ptr_gray_sync1, wr_ptr_gray_sync2;
-    reg [ADDR_WIDTH:0] rd_ptr_gray_sync1, rd_ptr_gray_sync2;
+    reg [ADDR_WIDTH:0]    wr_ptr_gray_sync1, wr_ptr_gray_sync2;
+    reg [RD_ADDR_WIDTH:0] rd_ptr_gray_sync1, rd_ptr_gray_sync2;
 
     // ----------------------------------------------------------------
     // 2. Memory (Infer Block RAM)
@@ -66,30 +87,55 @@ module simple_dcfifo #(
         end
     endfunction
 
+    // Read-side pointers are wider when RD_DATA_WIDTH < DATA_WIDTH
+    function [RD_ADDR_WIDTH:0] rd_bin2gray;
+        input [RD_ADDR_WIDTH:0] bin;
+        begin
+            rd_bin2gray = bin ^ (bin >> 1);
+        end
+    endfunction
+
+    function [RD_ADDR_WIDTH:0] rd_gray2bin;
+        input [RD_ADDR_WIDTH:0] gray;
+        integer i;
+        begin
+            rd_gray2bin[RD_ADDR_WIDTH] = gray[RD_ADDR_WIDTH];
+            for (i = RD_ADDR_WIDTH-1; i >= 0; i = i - 1)
+                rd_gray2bin[i] = rd_gray2bin[i+1] ^ gray[i];
+        end
+    endfunction
+
     // ----------------------------------------------------------------
     // 5. Initial for Simulation
     // ----------------------------------------------------------------
+    reg [DATA_WIDTH-1:0]    mem_q;    // RAM output register (full write word)
+    reg [RD_ADDR_WIDTH-1:0] lane_q;   // Lane select for mem_q
+    reg                     q_valid;  // FWFT: output register holds data
+
     integer i;
     initial begin
         wr_ptr_bin = 0; wr_ptr_gray = 0;
         rd_ptr_bin = 0; rd_ptr_gray = 0;
         wr_ptr_gray_sync1 = 0; wr_ptr_gray_sync2 = 0;
         rd_ptr_gray_sync1 = 0; rd_ptr_gray_sync2 = 0;
-        q = 0; // Initialize output to 0 to avoid X
+        mem_q = 0; lane_q = 0; // Initialize output to 0 to avoid X
+        q_valid = 0;
     end
 
     // ----------------------------------------------------------------
     // 6. Write Logic & Usage Calculation
     // ----------------------------------------------------------------
-    wire [ADDR_WIDTH:0] rd_ptr_bin_sync = gray2bin(rd_ptr_gray_sync2);
-    
-    // Check Full: Gray code comparison
-    // Full if top 2 bits differ, rest match
-    assign wrfull = (wr_ptr_gray == {~rd_ptr_gray_sync2[ADDR_WIDTH:ADDR_WIDTH-1], rd_ptr_gray_sync2[ADDR_WIDTH-2:0]});
-
-    // Used Words: Subtract Binary Pointers
-    wire [ADDR_WIDTH:0] used_diff = wr_ptr_bin - rd_ptr_bin_sync;
-    
+    wire [RD_ADDR_WIDTH:0] rd_ptr_bin_sync = rd_gray2bin(rd_ptr_gray_sync2);
+
+    // Used Words: Subtract Binary Pointers (in write-side words)
+    // A write word is freed only after its last lane has been read
+    wire [ADDR_WIDTH:0] rd_ptr_wr_units = rd_ptr_bin_sync >> RATIO_LOG2;
+    wire [ADDR_WIDTH:0] used_diff = wr_ptr_bin - rd_ptr_wr_units;
+
+    // Check Full: usage reached the depth (bit ADDR_WIDTH set)
+    // For RATIO == 1 this is identical to the classic Gray code comparison
+    assign wrfull = used_diff[ADDR_WIDTH];
+
     // Saturate to Max Value (all 1s) if actual usage is Full (bit ADDR_WIDTH is 1)
     // This protects against wrapping to 0 which would confuse the DMA Master
     assign wrusedw = (used_diff[ADDR_WIDTH]) ? {ADDR_WIDTH{1'b1}} : used_diff[ADDR_WIDTH-1:0];
@@ -105,15 +151,39 @@ module simple_dcfifo #(
     // ----------------------------------------------------------------
     // 7. Read Logic
     // ----------------------------------------------------------------
-    // Check Empty: Gray code pointers match exactly
-    assign rdempty = (rd_ptr_gray == wr_ptr_gray_sync2);
+    // Write pointer converted to read-side words
+    wire [RD_ADDR_WIDTH:0] wr_ptr_rd_units = gray2bin(wr_ptr_gray_sync2) << RATIO_LOG2;
+
+    // RAM Empty: no unread lane left in memory
+    wire ram_empty = (rd_ptr_bin == wr_ptr_rd_units);
+
+    // Normal: read on rdreq. FWFT: prefetch whenever the output register is free
+    // or being acknowledged in this cycle.
+    wire ram_rd = SHOW_AHEAD ? (!ram_empty && (!q_valid || rdreq))
+                             : (!ram_empty && rdreq);
+
+    assign rdempty = SHOW_AHEAD ? !q_valid : ram_empty;
+
+    wire [RD_ADDR_WIDTH-1:0] rd_addr = rd_ptr_bin[RD_ADDR_WIDTH-1:0];
 
     always @(posedge rdclk) begin
-        if (rdreq && !rdempty) begin
-            q <= mem[rd_ptr_bin[ADDR_WIDTH-1:0]];
+        if (ram_rd) begin
+            mem_q  <= mem[rd_addr >> RATIO_LOG2];
+            lane_q <= rd_addr & (RATIO - 1);
             rd_ptr_bin <= rd_ptr_bin + 1;
-            rd_ptr_gray <= bin2gray(rd_ptr_bin + 1);
+            rd_ptr_gray <= rd_bin2gray(rd_ptr_bin + 1);
         end
+
+        if (ram_rd)
+            q_valid <= 1'b1;
+        else if (rdreq)
+            q_valid <= 1'b0;
     end
 
+    assign q = mem_q >> (lane_q * RD_DATA_WIDTH);
+
+    // Read-side usage (FWFT output register counts as one word)
+    wire [RD_ADDR_WIDTH:0] rd_used_diff = wr_ptr_rd_units - rd_ptr_bin + ((SHOW_AHEAD && q_valid) ? 1 : 0);
+    assign rdusedw = (rd_used_diff[RD_ADDR_WIDTH]) ? {RD_ADDR_WIDTH{1'b1}} : rd_used_diff[RD_ADDR_WIDTH-1:0];
+
 endmodule
@@ -0,0 +1,251 @@
+`timescale 1ns/1ps
+
+// AXI3 Read Master for Video Scanout
+//
+// Same control interface as video_dma_master, but talks AXI3 directly to the
+// 64-bit F2H bridge instead of going through the Avalon->AXI translation.
+//
+// - INCR bursts of up to 16 beats (128 bytes), never crossing a 4KB boundary
+// - Up to MAX_OUTSTANDING reads in flight, one ARID per slot
+// - The HPS may return different IDs out of order, so each slot owns a 16-beat
+//   region of a reorder buffer (ROB) which is drained to the FIFO in issue order
+// - RRESP SLVERR/DECERR beats are still drained (the frame keeps its timing),
+//   but rd_err reports them for the last frame
+// - FIFO write side is DATA_WIDTH (use simple_dcfifo with RD_DATA_WIDTH=32)
+
+module video_dma_axi_master #(
+    parameter H_RES            = 1280,
+    parameter V_RES            = 720,
+    parameter DATA_WIDTH       = 64,
+    parameter ID_WIDTH         = 4,
+    parameter MAX_OUTSTANDING  = 8,    // Power of 2, <= 2**ID_WIDTH
+    parameter FIFO_ADDR_WIDTH  = 8,    // FIFO depth in DATA_WIDTH words (2**N)
+    parameter FRAME_SIZE_BEATS = H_RES * V_RES * 4 / (DATA_WIDTH / 8)
+)(
+    input  wire                       clk,
+    input  wire                       reset_n,
+    input  wire [31:0]                start_addr,
+
+    // Control & Status
+    input  wire                       dma_start,   // Pulse to start a single frame transfer
+    input  wire                       dma_cont_en, // Continuous mode enable
+    output reg                        dma_done,    // Pulse when one frame is finished
+    output wire                       busy,
+    input  wire                       vsync_edge,  // Trigger for new frame in continuous mode
+
+    // AXI3 Read Address Channel
+    output reg  [ID_WIDTH-1:0]        axm_arid,
+    output reg  [31:0]                axm_araddr,
+    output reg  [3:0]                 axm_arlen,
+    output wire [2:0]                 axm_arsize,
+    output wire [1:0]                 axm_arburst,
+    output wire [1:0]                 axm_arlock,
+    output wire [3:0]                 axm_arcache,
+    output wire [2:0]                 axm_arprot,
+    output reg                        axm_arvalid,
+    input  wire                       axm_arready,
+
+    // AXI3 Read Data Channel
+    input  wire [ID_WIDTH-1:0]        axm_rid,
+    input  wire [DATA_WIDTH-1:0]      axm_rdata,
+    input  wire [1:0]                 axm_rresp,
+    input  wire                       axm_rlast,
+    input  wire                       axm_rvalid,
+    output wire                       axm_rready,
+
+    // FIFO Interface (Write side)
+    input  wire [FIFO_ADDR_WIDTH-1:0] fifo_used,
+    output reg                        fifo_wr_en,
+    output reg  [DATA_WIDTH-1:0]      fifo_wr_data,
+
+    // Statistics
+    output reg  [15:0]                split_cnt,   // Bursts shorter than 16 beats, last frame
+    output reg                        rd_err       // RRESP SLVERR/DECERR seen, last frame
+);
+
+    localparam MAX_BEATS      = 16;                       // AXI3 ARLEN limit
+    localparam BYTES_PER_BEAT = DATA_WIDTH / 8;
+    localparam SIZE_LOG2      = $clog2(BYTES_PER_BEAT);
+    localparam SLOT_BITS      = $clog2(MAX_OUTSTANDING);
+    localparam FIFO_DEPTH     = (1 << FIFO_ADDR_WIDTH);
+
+    // Fixed AXI attributes
+    assign axm_arsize  = SIZE_LOG2[2:0];
+    assign axm_arburst = 2'b01;   // INCR
+    assign axm_arlock  = 2'b00;   // Normal
+    assign axm_arcache = 4'b0011; // Bufferable, Modifiable
+    assign axm_arprot  = 3'b000;
+    assign axm_rready  = 1'b1;    // ROB space is reserved at issue time
+
+    // FSM States
+    localparam IDLE = 1'b0;
+    localparam RUN  = 1'b1;
+
+    reg        state;
+    reg        is_cont_mode;
+    reg        frame_active;
+
+    assign busy = frame_active;
+
+    wire frame_trigger = dma_start || (dma_cont_en && vsync_edge);
+
+    // ------------------------------------------------------------------
+    // Slot bookkeeping
+    // ------------------------------------------------------------------
+    reg [MAX_OUTSTANDING-1:0] slot_busy;    // Issued, not yet drained
+    reg [MAX_OUTSTANDING-1:0] slot_done;    // All beats received (RLAST)
+    reg [4:0]                 slot_len [0:MAX_OUTSTANDING-1];
+    reg [3:0]                 rx_beat  [0:MAX_OUTSTANDING-1];
+
+    reg [SLOT_BITS-1:0] iss_ptr;
+    reg [SLOT_BITS-1:0] drn_ptr;
+    reg [3:0]           drn_beat;
+
+    // Command generator
+    reg [31:0] cmd_addr;
+    reg [31:0] cmd_beats_left;
+    reg [31:0] beats_drained;
+    reg [15:0] frame_split_cnt;
+    reg        frame_rd_err;
+
+    // Next burst: min(16, beats to 4KB boundary, beats left)
+    wire [12:0] bytes_to_4k = 13'd4096 - {1'b0, cmd_addr[11:0]};
+    wire [12:0] beats_to_4k = bytes_to_4k >> SIZE_LOG2;
+    wire [4:0]  len_4k      = (beats_to_4k < MAX_BEATS) ? beats_to_4k[4:0] : MAX_BEATS[4:0];
+    wire [4:0]  next_len    = (cmd_beats_left < len_4k) ? cmd_beats_left[4:0] : len_4k;
+
+    wire can_issue = (state == RUN) && (cmd_beats_left != 0) &&
+                     !slot_busy[iss_ptr] && !axm_arvalid;
+
+    // Drain one beat per clock while the FIFO has room
+    // (margin covers the ROB read register and the wrusedw update latency)
+    wire fifo_room = (fifo_used < FIFO_DEPTH - 4);
+    wire can_drain = slot_done[drn_ptr] && fifo_room;
+
+    wire [SLOT_BITS-1:0] r_slot = axm_rid[SLOT_BITS-1:0];
+
+    // ------------------------------------------------------------------
+    // 1. Reorder Buffer (Infer Block RAM)
+    // ------------------------------------------------------------------
+    reg [DATA_WIDTH-1:0] rob [0:MAX_OUTSTANDING*MAX_BEATS-1];
+
+    always @(posedge clk) begin
+        if (axm_rvalid)
+            rob[{r_slot, rx_beat[r_slot]}] <= axm_rdata;
+        if (can_drain)
+            fifo_wr_data <= rob[{drn_ptr, drn_beat}];
+    end
+
+    // ------------------------------------------------------------------
+    // 2. Main Control (Command Issue, Response Tracking, Drain)
+    // ------------------------------------------------------------------
+    integer i;
+    always @(posedge clk or negedge reset_n) begin
+        if (!reset_n) begin
+            state <= IDLE;
+            is_cont_mode <= 1'b0;
+            frame_active <= 1'b0;
+            axm_arvalid <= 1'b0;
+            axm_araddr <= 32'd0;
+            axm_arlen <= 4'd0;
+            axm_arid <= 0;
+            cmd_addr <= 32'd0;
+            cmd_beats_left <= 32'd0;
+            beats_drained <= 32'd0;
+            frame_split_cnt <= 16'd0;
+            split_cnt <= 16'd0;
+            frame_rd_err <= 1'b0;
+            rd_err <= 1'b0;
+            slot_busy <= 0;
+            slot_done <= 0;
+            iss_ptr <= 0;
+            drn_ptr <= 0;
+            drn_beat <= 4'd0;
+            fifo_wr_en <= 1'b0;
+            dma_done <= 1'b0;
+            for (i = 0; i < MAX_OUTSTANDING; i = i + 1) begin
+                slot_len[i] <= 5'd0;
+                rx_beat[i] <= 4'd0;
+            end
+        end else begin
+            dma_done <= 1'b0;
+            fifo_wr_en <= can_drain;
+
+            // AR handshake
+            if (axm_arvalid && axm_arready)
+                axm_arvalid <= 1'b0;
+
+            case (state)
+                IDLE: begin
+                    if (frame_trigger) begin
+                        cmd_addr <= start_addr;
+                        cmd_beats_left <= FRAME_SIZE_BEATS;
+                        beats_drained <= 32'd0;
+                        frame_split_cnt <= 16'd0;
+                        frame_rd_err <= 1'b0;
+                        is_cont_mode <= !dma_start;
+                        frame_active <= 1'b1;
+                        state <= RUN;
+                    end else begin
+                        frame_active <= 1'b0;
+                    end
+                end
+
+                RUN: begin
+                    if (can_issue) begin
+                        axm_arvalid <= 1'b1;
+                        axm_araddr <= cmd_addr;
+                        axm_arlen <= next_len - 5'd1;
+                        axm_arid <= iss_ptr;
+                        slot_busy[iss_ptr] <= 1'b1;
+                        slot_len[iss_ptr] <= next_len;
+                        iss_ptr <= iss_ptr + 1'b1;
+                        cmd_addr <= cmd_addr + (next_len << SIZE_LOG2);
+                        cmd_beats_left <= cmd_beats_left - next_len;
+                        if (next_len != MAX_BEATS)
+                            frame_split_cnt <= frame_split_cnt + 1'b1;
+                    end
+
+                    if (can_drain) begin
+                        beats_drained <= beats_drained + 1;
+                        if (drn_beat == slot_len[drn_ptr] - 1) begin
+                            slot_busy[drn_ptr] <= 1'b0;
+                            slot_done[drn_ptr] <= 1'b0;
+                            drn_ptr <= drn_ptr + 1'b1;
+                            drn_beat <= 4'd0;
+                        end else begin
+                            drn_beat <= drn_beat + 1'b1;
+                        end
+
+                        if (beats_drained == FRAME_SIZE_BEATS - 1) begin
+                            dma_done <= 1'b1;
+                            split_cnt <= frame_split_cnt;
+                            rd_err <= frame_rd_err;
+                            frame_active <= 1'b0;
+                            state <= IDLE;
+                        end
+                    end
+                end
+            endcase
+
+            // R channel: count beats per ID, mark slot complete on RLAST
+            // RRESP[1] set: SLVERR (2'b10) or DECERR (2'b11)
+            if (axm_rvalid) begin
+                if (axm_rresp[1])
+                    frame_rd_err <= 1'b1;
+                if (axm_rlast) begin
+                    rx_beat[r_slot] <= 4'd0;
+                    slot_done[r_slot] <= 1'b1;
+                end else begin
+                    rx_beat[r_slot] <= rx_beat[r_slot] + 1'b1;
+                end
+            end
+
+            // Continuous mode is dropped between frames
+            if (is_cont_mode && !dma_cont_en && state == IDLE) begin
+                is_cont_mode <= 1'b0;
+            end
+        end
+    end
+
+endmodule
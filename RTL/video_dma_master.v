@@ -18,15 +18,21 @@ module video_dma_master (
     input  wire         m_readdatavalid,
     output reg  [31:0]  m_address,
     output reg          m_read,
-    output wire [7:0]   m_burstcount,
+    output reg  [7:0]   m_burstcount,
     
     // FIFO Interface (Write side)
     input  wire [8:0]   fifo_used,
     output wire         fifo_wr_en,
-    output wire [31:0]  fifo_wr_data
+    output wire [31:0]  fifo_wr_data,
+
+    // Statistics
+    output reg  [15:0]  split_cnt    // Shortened bursts in the last completed frame
 );
 
     // Initial Parameters
+    // Bursts are aligned to BURST_LEN*4 bytes (power of 2, divides 4KB):
+    // an unaligned start_addr gets a short first burst, the frame tail a short
+    // last burst, and everything in between is a full aligned burst.
     parameter BURST_LEN = 8'd64;       // Burst size (256 bytes)
     parameter FIFO_DEPTH = 512;        // FIFO size in words
     parameter H_RES = 1280;
@@ -50,8 +56,16 @@ module video_dma_master (
     reg is_cont_mode;
     reg frame_active; // Starts on Trigger, Ends when words_received == FRAME_SIZE
 
+    reg [15:0] frame_split_cnt;
+
+    // Burst Shaping: min(BURST_LEN, words to next alignment, words left in frame)
+    localparam ALIGN_BYTES = BURST_LEN * 4;
+    wire [31:0] words_to_align = (ALIGN_BYTES - (current_read_addr & (ALIGN_BYTES - 1))) >> 2;
+    wire [31:0] words_left     = FRAME_SIZE_WORDS - words_commanded;
+    wire [31:0] align_len      = (words_to_align < BURST_LEN) ? words_to_align : BURST_LEN;
+    wire [7:0]  next_len       = (words_left < align_len) ? words_left[7:0] : align_len[7:0];
+
     // Assignments
-    assign m_burstcount = BURST_LEN;
     assign fifo_wr_en   = m_readdatavalid;
     assign fifo_wr_data = m_readdata;
     assign busy         = frame_active;
@@ -64,8 +78,10 @@ module video_dma_master (
             state <= IDLE;
             m_address <= 32'd0;
             m_read <= 1'b0;
+            m_burstcount <= BURST_LEN;
             current_read_addr <= 32'd0;
             words_commanded <= 32'd0;
+            frame_split_cnt <= 16'd0;
             is_cont_mode <= 1'b0;
             frame_active <= 1'b0;
             pending_bursts <= 10'd0;
@@ -84,6 +100,7 @@ module video_dma_master (
                 IDLE: begin
                     m_read <= 1'b0;
                     words_commanded <= 32'd0;
+                    frame_split_cnt <= 16'd0;
                     
                     // Trigger Logic
                     if (dma_start) begin
@@ -115,7 +132,10 @@ module video_dma_master (
                     else if ((fifo_used + (words_commanded - words_received)) <= (FIFO_DEPTH - BURST_LEN - 2)) begin
                         // Safe to issue a read
                         m_address <= current_read_addr;
+                        m_burstcount <= next_len;
                         m_read <= 1'b1;
+                        if (next_len != BURST_LEN)
+                            frame_split_cnt <= frame_split_cnt + 1'b1;
                         state <= ISSUE_READ;
                     end
                     // Else: Wait here until data is drained from FIFO or received
@@ -125,8 +145,8 @@ module video_dma_master (
                     if (!m_waitrequest) begin
                         // Command Accepted
                         m_read <= 1'b0;
-                        current_read_addr <= current_read_addr + (BURST_LEN * 4);
-                        words_commanded <= words_commanded + BURST_LEN;
+                        current_read_addr <= current_read_addr + (m_burstcount * 4);
+                        words_commanded <= words_commanded + m_burstcount;
                         state <= CHECK_FIFO;
                     end
                     // Else: Stay in ISSUE_READ with m_read high
@@ -174,11 +194,14 @@ module video_dma_master (
     // 3. Done Pulse Generation
     // ------------------------------------------------------------------
     always @(posedge clk or negedge reset_n) begin
-        if (!reset_n) dma_done <= 1'b0;
-        else begin
+        if (!reset_n) begin
+            dma_done <= 1'b0;
+            split_cnt <= 16'd0;
+        end else begin
             // Fire Done when we just finished receiving the last word
             if (m_readdatavalid && (words_received == FRAME_SIZE_WORDS - 1)) begin
                 dma_done <= 1'b1;
+                split_cnt <= frame_split_cnt;
             end else begin
                 dma_done <= 1'b0;
             end
@@ -1,12 +1,22 @@
 `timescale 1ns/1ps
 
-module video_pipeline (
+module video_pipeline #(
+    // Scanout master selection
+    // 0: Avalon-MM video_dma_master (32-bit, via video_dma bridge)
+    // 1: AXI3 video_dma_axi_master (64-bit, via video_axi bridge to F2H)
+    parameter DMA_AXI = 0,
+    // QoS: qos_urgent rises below URGENT_LOW pixels in the scanout FIFO (while
+    // a frame is being fetched) and falls again at URGENT_HIGH (hysteresis)
+    parameter URGENT_LOW  = 128,
+    parameter URGENT_HIGH = 256
+)(
     // Clocks & Reset
-    input  wire         clk_50,             // DMA & FIFO Write Clock
+    input  wire         clk_50,             // CSR Clock
+    input  wire         clk_dma,            // DMA & FIFO Write Clock (100 MHz, may equal clk_50)
     input  wire         clk_hdmi,           // HDMI Pixel Clock (~37.8 MHz)
     input  wire         reset_n,
 
-    // Avalon-MM Master Interface (to DDR3)
+    // Avalon-MM Master Interface (to DDR3, clk_dma domain)
     input  wire         m_waitrequest,
     input  wire [31:0]  m_readdata,
     input  wire         m_readdatavalid,
@@ -14,6 +24,24 @@ module video_pipeline (
     output wire         m_read,
     output wire [7:0]   m_burstcount,
 
+    // AXI3 Read Master Interface (to F2H bridge, clk_dma domain, DMA_AXI=1)
+    output wire [3:0]   axm_arid,
+    output wire [31:0]  axm_araddr,
+    output wire [3:0]   axm_arlen,
+    output wire [2:0]   axm_arsize,
+    output wire [1:0]   axm_arburst,
+    output wire [1:0]   axm_arlock,
+    output wire [3:0]   axm_arcache,
+    output wire [2:0]   axm_arprot,
+    output wire         axm_arvalid,
+    input  wire         axm_arready,
+    input  wire [3:0]   axm_rid,
+    input  wire [63:0]  axm_rdata,
+    input  wire [1:0]   axm_rresp,
+    input  wire         axm_rlast,
+    input  wire         axm_rvalid,
+    output wire         axm_rready,
+
     // Avalon-MM Slave Interface (Control from Nios II)
     input  wire [2:0]   s_address,
     input  wire         s_read,
@@ -27,6 +55,10 @@ module video_pipeline (
     output wire         hdmi_de,
     output wire         hdmi_hs,
     output wire         hdmi_vs,
+
+    // QoS (clk_dma domain): pause bulk DMA, scanout FIFO running low
+    output reg          qos_urgent,
+
     // Debug LEDs
     output wire [7:0]   debug_leds
 );
@@ -38,9 +70,8 @@ module video_pipeline (
 
     // Internal signals (Missing declarations added)
     wire [31:0] shadow_ptr;
-    wire [8:0]  fifo_used;
     wire        fifo_wr_en;
-    wire [31:0] fifo_wr_data;
+    wire        fifo_half;
     wire        fifo_full;
     wire        fifo_rd_en;
     wire [31:0] fifo_rd_data;
@@ -49,76 +80,263 @@ module video_pipeline (
     wire        dma_en;
     wire [31:0] reg_mode;
     wire        dma_done_50;
-    // wire        dma_start_74; // Removed, using direct connection
-    // wire        dma_cont_74;  // Removed, using direct connection
+    wire        dma_done_dma;     // Done pulse in clk_dma domain
+    wire        dma_busy_dma;     // Busy level in clk_dma domain
+    wire [15:0] dma_split_cnt_dma; // Split bursts of the last frame (clk_dma, updated on done)
+    wire        dma_rd_err_dma;    // Read error in the last frame (clk_dma, updated on done)
+    wire [9:0]  fifo_level_px;    // Scanout FIFO level in pixels (clk_dma domain)
 
     // Pipeline status (Internal)
     wire [7:0]  pipeline_debug;
-    
-    // 1. CDC (V-Sync, Start, Cont, Done)
+
+    // 0. Reset Synchronizers
+    // reset_n asserts asynchronously and is released two clocks later in each
+    // domain, so no flop sees the deassertion edge inside its recovery window.
+    // The pixel domain has its own synchronizer inside hdmi_sync_gen.
+    reg [1:0] reset_sync_50, reset_sync_dma;
+    always @(posedge clk_50 or negedge reset_n) begin
+        if (!reset_n) reset_sync_50 <= 2'b0;
+        else reset_sync_50 <= {reset_sync_50[0], 1'b1};
+    end
+    always @(posedge clk_dma or negedge reset_n) begin
+        if (!reset_n) reset_sync_dma <= 2'b0;
+        else reset_sync_dma <= {reset_sync_dma[0], 1'b1};
+    end
+    wire reset_50_n  = reset_sync_50[1];
+    wire dma_reset_n = reset_sync_dma[1];
+
+    // 1. CDC (V-Sync, Start, Cont, Done, Busy)
+    // CSR (hdmi_sync_gen) runs on clk_50, the DMA master and FIFO write side on clk_dma.
+    // Pulses cross as toggles, levels through a double flop.
+    //
     // 1.1 V-Sync: 74MHz -> 50MHz (Using Toggle from Sync Gen)
     reg [2:0] vsync_toggle_sync_50;
-    always @(posedge clk_50 or negedge reset_n) begin
-        if (!reset_n) vsync_toggle_sync_50 <= 3'b0;
+    always @(posedge clk_50 or negedge reset_50_n) begin
+        if (!reset_50_n) vsync_toggle_sync_50 <= 3'b0;
         else vsync_toggle_sync_50 <= {vsync_toggle_sync_50[1:0], vs_toggle_raw};
     end
     wire vsync_edge_sync = vsync_toggle_sync_50[2] ^ vsync_toggle_sync_50[1]; // Edge Detect
 
-    // 1.2 Start & Cont: 50MHz -> 50MHz (Direct Connection)
-    // No CDC needed as both CSR (Nios) and DMA Master are on clk_50
+    // 1.2 Start & V-Sync: 50MHz -> clk_dma (Toggle)
+    // The toggles flip one cycle after the 50MHz event, so shadow_ptr (updated on
+    // the same V-Sync) is already stable when the DMA samples it as start_addr.
     wire dma_start_direct;
     wire dma_cont_direct;
-    
-    // 1.3 Done: 50MHz -> 50MHz (Direct Connection)
+
+    reg start_toggle_50, vsync_toggle_50;
+    always @(posedge clk_50 or negedge reset_50_n) begin
+        if (!reset_50_n) begin
+            start_toggle_50 <= 1'b0;
+            vsync_toggle_50 <= 1'b0;
+        end else begin
+            if (dma_start_direct) start_toggle_50 <= ~start_toggle_50;
+            if (vsync_edge_sync)  vsync_toggle_50 <= ~vsync_toggle_50;
+        end
+    end
+
+    reg [2:0] start_sync_dma, vsync_sync_dma;
+    reg [1:0] cont_sync_dma;
+    always @(posedge clk_dma or negedge dma_reset_n) begin
+        if (!dma_reset_n) begin
+            start_sync_dma <= 3'b0;
+            vsync_sync_dma <= 3'b0;
+            cont_sync_dma  <= 2'b0;
+        end else begin
+            start_sync_dma <= {start_sync_dma[1:0], start_toggle_50};
+            vsync_sync_dma <= {vsync_sync_dma[1:0], vsync_toggle_50};
+            cont_sync_dma  <= {cont_sync_dma[0], dma_cont_direct};
+        end
+    end
+    wire dma_start_dma = start_sync_dma[2] ^ start_sync_dma[1];
+    wire vsync_edge_dma = vsync_sync_dma[2] ^ vsync_sync_dma[1];
+    wire dma_cont_dma  = cont_sync_dma[1];
+
+    // 1.3 Done & Busy: clk_dma -> 50MHz
+    reg done_toggle_dma;
+    always @(posedge clk_dma or negedge dma_reset_n) begin
+        if (!dma_reset_n) done_toggle_dma <= 1'b0;
+        else if (dma_done_dma) done_toggle_dma <= ~done_toggle_dma;
+    end
+
+    reg [2:0] done_sync_50;
+    reg [1:0] busy_sync_50;
+    always @(posedge clk_50 or negedge reset_50_n) begin
+        if (!reset_50_n) begin
+            done_sync_50 <= 3'b0;
+            busy_sync_50 <= 2'b0;
+        end else begin
+            done_sync_50 <= {done_sync_50[1:0], done_toggle_dma};
+            busy_sync_50 <= {busy_sync_50[0], dma_busy_dma};
+        end
+    end
+    assign dma_done_50 = done_sync_50[2] ^ done_sync_50[1];
+    assign dma_busy    = busy_sync_50[1];
+
     wire dma_done_direct;
     assign dma_done_direct = dma_done_50;
 
-    // 2. Video DMA Master (Reads from DDR3)
-    video_dma_master #(
-        .H_RES(960),
-        .V_RES(540)
-    ) u_dma_master (
-        .clk               (clk_50),
-        .reset_n           (reset_n),
-        .start_addr        (shadow_ptr),
-        .dma_start         (dma_start_direct),
-        .dma_cont_en       (dma_cont_direct),
-        .dma_done          (dma_done_50),
-        .vsync_edge        (vsync_edge_sync),
-        .m_waitrequest     (m_waitrequest),
-        .m_readdata        (m_readdata),
-        .m_readdatavalid   (m_readdatavalid),
-        .m_address         (m_address),
-        .m_read            (m_read),
-        .m_burstcount      (m_burstcount),
-        .fifo_used         (fifo_used),
-        .fifo_wr_en        (fifo_wr_en),
-        .fifo_wr_data      (fifo_wr_data),
-        .busy              (dma_busy)
-    );
+    // 1.4 Split Count & Read Error: clk_dma -> 50MHz
+    // Updated together with dma_done_dma and held for a whole frame, so they are
+    // stable when the done toggle arrives here.
+    reg [15:0] dma_split_cnt_50;
+    reg        dma_rd_err_50;
+    always @(posedge clk_50 or negedge reset_50_n) begin
+        if (!reset_50_n) begin
+            dma_split_cnt_50 <= 16'd0;
+            dma_rd_err_50 <= 1'b0;
+        end else if (dma_done_50) begin
+            dma_split_cnt_50 <= dma_split_cnt_dma;
+            dma_rd_err_50 <= dma_rd_err_dma;
+        end
+    end
 
-    // 3. Simple Dual Clock FIFO (Verilog Only)
-    simple_dcfifo #(
-        .DATA_WIDTH(32),
-        .ADDR_WIDTH(9) // 512 depth
-    ) u_simple_fifo (
-        .wrclk   (clk_50),
-        .data    (fifo_wr_data),
-        .wrreq   (fifo_wr_en),
-        .wrusedw (fifo_used),
-        .wrfull  (fifo_full),
-        
-        .rdclk   (clk_hdmi),
-        .rdreq   (fifo_rd_en),
-        .q       (fifo_rd_data),
-        .rdempty (fifo_empty)
-    );
+    // 2. Video DMA Master (Reads from DDR3) & 3. Simple Dual Clock FIFO
+    generate
+    if (DMA_AXI) begin : g_axi
+        // AXI3: 64-bit bursts, FIFO converts 64 -> 32 (lower pixel first)
+        wire [7:0]  fifo_used;
+        wire [63:0] fifo_wr_data;
+
+        video_dma_axi_master #(
+            .H_RES(960),
+            .V_RES(540),
+            .DATA_WIDTH(64),
+            .ID_WIDTH(4),
+            .MAX_OUTSTANDING(8),
+            .FIFO_ADDR_WIDTH(8)
+        ) u_dma_master (
+            .clk               (clk_dma),
+            .reset_n           (dma_reset_n),
+            .start_addr        (shadow_ptr),       // Quasi-static, see 1.2
+            .dma_start         (dma_start_dma),
+            .dma_cont_en       (dma_cont_dma),
+            .dma_done          (dma_done_dma),
+            .busy              (dma_busy_dma),
+            .vsync_edge        (vsync_edge_dma),
+            .axm_arid          (axm_arid),
+            .axm_araddr        (axm_araddr),
+            .axm_arlen         (axm_arlen),
+            .axm_arsize        (axm_arsize),
+            .axm_arburst       (axm_arburst),
+            .axm_arlock        (axm_arlock),
+            .axm_arcache       (axm_arcache),
+            .axm_arprot        (axm_arprot),
+            .axm_arvalid       (axm_arvalid),
+            .axm_arready       (axm_arready),
+            .axm_rid           (axm_rid),
+            .axm_rdata         (axm_rdata),
+            .axm_rresp         (axm_rresp),
+            .axm_rlast         (axm_rlast),
+            .axm_rvalid        (axm_rvalid),
+            .axm_rready        (axm_rready),
+            .fifo_used         (fifo_used),
+            .fifo_wr_en        (fifo_wr_en),
+            .fifo_wr_data      (fifo_wr_data),
+            .split_cnt         (dma_split_cnt_dma),
+            .rd_err            (dma_rd_err_dma)
+        );
+
+        simple_dcfifo #(
+            .DATA_WIDTH(64),
+            .ADDR_WIDTH(8),      // 256 x 64 = 512 pixels (same as Avalon path)
+            .RD_DATA_WIDTH(32)
+        ) u_simple_fifo (
+            .wrclk   (clk_dma),
+            .data    (fifo_wr_data),
+            .wrreq   (fifo_wr_en),
+            .wrusedw (fifo_used),
+            .wrfull  (fifo_full),
+
+            .rdclk   (clk_hdmi),
+            .rdreq   (fifo_rd_en),
+            .q       (fifo_rd_data),
+            .rdempty (fifo_empty),
+            .rdusedw ()
+        );
+
+        assign fifo_half = fifo_used[7];
+        assign fifo_level_px = {fifo_used, 1'b0};
+
+        assign m_address    = 32'd0;
+        assign m_read       = 1'b0;
+        assign m_burstcount = 8'd0;
+    end else begin : g_avalon
+        wire [8:0]  fifo_used;
+        wire [31:0] fifo_wr_data;
+
+        video_dma_master #(
+            .H_RES(960),
+            .V_RES(540)
+        ) u_dma_master (
+            .clk               (clk_dma),
+            .reset_n           (dma_reset_n),
+            .start_addr        (shadow_ptr),       // Quasi-static, see 1.2
+            .dma_start         (dma_start_dma),
+            .dma_cont_en       (dma_cont_dma),
+            .dma_done          (dma_done_dma),
+            .vsync_edge        (vsync_edge_dma),
+            .m_waitrequest     (m_waitrequest),
+            .m_readdata        (m_readdata),
+            .m_readdatavalid   (m_readdatavalid),
+            .m_address         (m_address),
+            .m_read            (m_read),
+            .m_burstcount      (m_burstcount),
+            .fifo_used         (fifo_used),
+            .fifo_wr_en        (fifo_wr_en),
+            .fifo_wr_data      (fifo_wr_data),
+            .busy              (dma_busy_dma),
+            .split_cnt         (dma_split_cnt_dma)
+        );
+
+        simple_dcfifo #(
+            .DATA_WIDTH(32),
+            .ADDR_WIDTH(9) // 512 depth
+        ) u_simple_fifo (
+            .wrclk   (clk_dma),
+            .data    (fifo_wr_data),
+            .wrreq   (fifo_wr_en),
+            .wrusedw (fifo_used),
+            .wrfull  (fifo_full),
+
+            .rdclk   (clk_hdmi),
+            .rdreq   (fifo_rd_en),
+            .q       (fifo_rd_data),
+            .rdempty (fifo_empty),
+            .rdusedw ()
+        );
+
+        assign fifo_half = fifo_used[8];
+        assign fifo_level_px = {1'b0, fifo_used};
+        assign dma_rd_err_dma = 1'b0;  // Avalon bridge has no response port (USE_RESPONSE=0)
+
+        assign axm_arid     = 4'd0;
+        assign axm_araddr   = 32'd0;
+        assign axm_arlen    = 4'd0;
+        assign axm_arsize   = 3'd0;
+        assign axm_arburst  = 2'd0;
+        assign axm_arlock   = 2'd0;
+        assign axm_arcache  = 4'd0;
+        assign axm_arprot   = 3'd0;
+        assign axm_arvalid  = 1'b0;
+        assign axm_rready   = 1'b1;
+    end
+    endgenerate
+
+    // 3.1 QoS Urgent (clk_dma domain)
+    // Only while a frame is being fetched: the FIFO drains to empty at the end of
+    // every frame, which must not pause bulk DMA during blanking.
+    always @(posedge clk_dma or negedge dma_reset_n) begin
+        if (!dma_reset_n) qos_urgent <= 1'b0;
+        else if (!dma_busy_dma) qos_urgent <= 1'b0;
+        else if (fifo_level_px < URGENT_LOW) qos_urgent <= 1'b1;
+        else if (fifo_level_px >= URGENT_HIGH) qos_urgent <= 1'b0;
+    end
 
     // 4. HDMI Sync & Pattern Generator
     hdmi_sync_gen u_hdmi_sync (
         .clk               (clk_50),           // CSR Clock
         .clk_pixel         (clk_hdmi),         // Pixel Clock
-        .reset_n           (reset_n),
+        .reset_n           (reset_50_n),       // Synchronized again for clk_pixel inside
         .hdmi_d            (hdmi_d),
         .hdmi_de           (hdmi_de),
         .hdmi_hs           (hdmi_hs),
@@ -140,6 +358,8 @@ module video_pipeline (
         
         .dma_busy          (dma_busy),
         .dma_done_in       (dma_done_direct),
+        .dma_split_cnt     (dma_split_cnt_50),
+        .dma_rd_err        (dma_rd_err_50),
         .dma_start_out     (dma_start_direct),
         .dma_cont_en_out   (dma_cont_direct),
         .vs_toggle         (vs_toggle_raw)
@@ -164,7 +384,7 @@ module video_pipeline (
     
     assign debug_leds[0] = fifo_wr_en;      // Data arriving from DDR3?
     assign debug_leds[1] = fifo_rd_en;      // HDMI consuming data?
-    assign debug_leds[2] = fifo_used[8];    // FIFO Half Full? (If 1, overflow risk)
+    assign debug_leds[2] = fifo_half;       // FIFO Half Full? (If 1, overflow risk)
     assign debug_leds[3] = fifo_empty;      // Is FIFO empty? (Should be 0 during play)
     assign debug_leds[4] = dma_start_direct;  
     assign debug_leds[5] = dma_cont_direct; 
@@ -156,5 +156,17 @@
 #define JTAG_UART_WRITE_DEPTH 64
 #define JTAG_UART_WRITE_THRESHOLD 8
 
+/*
+ * Macros for device 'burst_master_4_0', class 'burst_master_4'
+ * The macros are prefixed with 'BURST_MASTER_4_0_'.
+ * The prefix is the slave descriptor.
+ */
+#define BURST_MASTER_4_0_COMPONENT_TYPE burst_master_4
+#define BURST_MASTER_4_0_COMPONENT_NAME burst_master_4_0
+#define BURST_MASTER_4_0_BASE 0x20400
+#define BURST_MASTER_4_0_SPAN 256
+#define BURST_MASTER_4_0_END 0x204ff
+#define BURST_MASTER_4_0_IRQ 3
+
 
 #endif /* _ALTERA_HPS_0_H_ */
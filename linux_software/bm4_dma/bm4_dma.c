@@ -0,0 +1,271 @@
+#include "bm4_dma.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Burst Master 4 CSR (word offsets)
+#define REG_STATUS 1
+#define REG_IRQ_EN 39
+#define REG_CQ_PUSH 48
+#define REG_CQ_STATUS 49
+#define REG_CQ_RING 50
+#define REG_CQ_RING_SIZE 51
+#define REG_CQ_HEAD 52
+#define REG_CQ_TAIL 53
+
+#define IRQ_EN_DONE (1 << 0)
+#define CQ_STATUS_OVF (1 << 16)
+
+// Descriptor (16 words, see burst_master_4.v)
+#define DESC_WORDS 16
+#define D_NEXT 0
+#define D_STATUS 1
+#define D_SRC 2
+#define D_DST 3
+#define D_LEN 4
+#define D_BURST 5
+#define D_COEFF 6
+#define D_FLAGS 7
+#define D_PIX_OP 11
+#define DESC_FLAG_LAST (1 << 0)
+#define DESC_BURST(rd, wr) (((wr) << 16) | (rd))
+#define PIX_OP_PASS 1
+
+#define CPL_DESC 0
+#define CPL_STATUS 1
+#define CPL_DONE (1u << 31)
+
+// The descriptor must be in DDR before the CSR write that queues it; the two
+// take different paths (F2H vs lightweight bridge), so a DMB is not enough
+static inline void bm4_dsb(void) {
+#ifdef __arm__
+  __asm__ __volatile__("dsb" ::: "memory");
+#else
+  __sync_synchronize(); // Host builds, for syntax checks only
+#endif
+}
+
+static int read_sysfs(const char *name, const char *attr, unsigned long *val) {
+  static const char *const classes[] = {"u-dma-buf", "udmabuf"};
+  char path[96];
+  for (int i = 0; i < 2; i++) {
+    snprintf(path, sizeof(path), "/sys/class/%s/%s/%s", classes[i], name, attr);
+    FILE *f = fopen(path, "r");
+    if (!f)
+      continue;
+    char line[32];
+    int ok = fgets(line, sizeof(line), f) != NULL;
+    fclose(f);
+    if (!ok)
+      return -1;
+    *val = strtoul(line, NULL, 0); // phys_addr is hex, size is decimal
+    return 0;
+  }
+  return -1;
+}
+
+static int buf_mmap(bm4_buf_t *buf, off_t offset, size_t size) {
+  long page = sysconf(_SC_PAGESIZE);
+  off_t base = offset & ~(off_t)(page - 1);
+  buf->map_size = size + (offset - base);
+  buf->map = mmap(NULL, buf->map_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                  buf->fd, base);
+  if (buf->map == MAP_FAILED) {
+    perror("Error: mmap() failed");
+    close(buf->fd);
+    return -1;
+  }
+  buf->virt = (uint8_t *)buf->map + (offset - base);
+  buf->size = size;
+  return 0;
+}
+
+int bm4_buf_open(bm4_buf_t *buf, const char *name) {
+  unsigned long phys, size;
+  char path[64];
+
+  if (read_sysfs(name, "phys_addr", &phys) || read_sysfs(name, "size", &size)) {
+    fprintf(stderr, "Error: %s not found in sysfs (u-dma-buf loaded?)\n", name);
+    return -1;
+  }
+  snprintf(path, sizeof(path), "/dev/%s", name);
+  // O_SYNC: uncached mapping, the DMA sees CPU writes without a cache flush
+  buf->fd = open(path, O_RDWR | O_SYNC);
+  if (buf->fd == -1) {
+    perror("Error: could not open u-dma-buf device");
+    return -1;
+  }
+  buf->phys = phys;
+  return buf_mmap(buf, 0, size);
+}
+
+int bm4_buf_map(bm4_buf_t *buf, uint32_t phys, size_t size) {
+  buf->fd = open("/dev/mem", O_RDWR | O_SYNC);
+  if (buf->fd == -1) {
+    perror("Error: could not open \"/dev/mem\"");
+    return -1;
+  }
+  buf->phys = phys;
+  return buf_mmap(buf, phys, size);
+}
+
+void bm4_buf_close(bm4_buf_t *buf) {
+  munmap(buf->map, buf->map_size);
+  close(buf->fd);
+}
+
+unsigned long bm4_uio_map_addr(const char *dev) {
+  char path[64];
+  unsigned long addr = 0;
+  const char *name = strrchr(dev, '/');
+  snprintf(path, sizeof(path), "/sys/class/uio/%s/maps/map0/addr",
+           name ? name + 1 : dev);
+  FILE *f = fopen(path, "r");
+  if (f) {
+    if (fscanf(f, "%lx", &addr) != 1)
+      addr = 0;
+    fclose(f);
+  }
+  return addr;
+}
+
+int bm4_open(bm4_dev_t *dev, const char *uio, bm4_buf_t *ctl, size_t ctl_off) {
+  if (ctl_off + BM4_CTL_BYTES > ctl->size || (ctl->phys + ctl_off) & 0xF) {
+    fprintf(stderr, "Error: control area outside buffer or not 16B aligned\n");
+    return -1;
+  }
+
+  dev->fd = open(uio, O_RDWR);
+  if (dev->fd == -1) {
+    perror("Error: could not open UIO device");
+    return -1;
+  }
+  long page = sysconf(_SC_PAGESIZE);
+  dev->map_size = page;
+  dev->map = mmap(NULL, page, PROT_READ | PROT_WRITE, MAP_SHARED, dev->fd, 0);
+  if (dev->map == MAP_FAILED) {
+    perror("Error: mmap() failed");
+    close(dev->fd);
+    return -1;
+  }
+  dev->csr = (volatile uint32_t *)((uint8_t *)dev->map +
+                                   (bm4_uio_map_addr(uio) & (page - 1)));
+
+  // Descriptors first, ring after them
+  dev->desc = (volatile uint32_t *)((uint8_t *)ctl->virt + ctl_off);
+  dev->ring = dev->desc + BM4_SLOTS * DESC_WORDS;
+  dev->desc_phys = ctl->phys + ctl_off;
+  dev->ring_phys = dev->desc_phys + BM4_SLOTS * DESC_WORDS * 4;
+
+  for (int i = 0; i < BM4_SLOTS * DESC_WORDS; i++)
+    dev->desc[i] = 0;
+  for (int i = 0; i < BM4_SLOTS * 4; i++)
+    dev->ring[i] = 0;
+  bm4_dsb();
+
+  // Tickets follow CQ_HEAD so an engine that already ran commands is fine
+  uint32_t head = dev->csr[REG_CQ_HEAD] & 0xFFFF;
+  dev->submitted = dev->reaped = head;
+  dev->csr[REG_CQ_RING] = dev->ring_phys;
+  dev->csr[REG_CQ_RING_SIZE] = BM4_SLOTS;
+  dev->csr[REG_CQ_TAIL] = head;
+  dev->csr[REG_CQ_STATUS] = CQ_STATUS_OVF;
+  dev->csr[REG_STATUS] = 1;
+  dev->csr[REG_IRQ_EN] = IRQ_EN_DONE;
+  return 0;
+}
+
+void bm4_close(bm4_dev_t *dev) {
+  dev->csr[REG_IRQ_EN] = 0;
+  dev->csr[REG_CQ_RING_SIZE] = 0;
+  dev->csr[REG_STATUS] = 1;
+  munmap(dev->map, dev->map_size);
+  close(dev->fd);
+}
+
+int bm4_submit_copy(bm4_dev_t *dev, uint32_t dst, uint32_t src, uint32_t len,
+                    uint32_t *ticket) {
+  if (dev->submitted - dev->reaped >= BM4_SLOTS) {
+    errno = EAGAIN;
+    return -1;
+  }
+
+  unsigned int slot = dev->submitted % BM4_SLOTS;
+  volatile uint32_t *d = dev->desc + slot * DESC_WORDS;
+  d[D_NEXT] = 0;
+  d[D_STATUS] = 0;
+  d[D_SRC] = src;
+  d[D_DST] = dst;
+  d[D_LEN] = len;
+  d[D_BURST] = DESC_BURST(256, 256);
+  d[D_COEFF] = 400;
+  d[D_FLAGS] = DESC_FLAG_LAST;
+  for (int i = D_FLAGS + 1; i < DESC_WORDS; i++)
+    d[i] = 0;
+  d[D_PIX_OP] = PIX_OP_PASS;
+  bm4_dsb();
+
+  dev->csr[REG_CQ_PUSH] = dev->desc_phys + slot * DESC_WORDS * 4;
+  *ticket = dev->submitted++;
+  return 0;
+}
+
+// Reads new completions from the ring and hands their slots back
+static void bm4_reap(bm4_dev_t *dev) {
+  uint16_t head16 = dev->csr[REG_CQ_HEAD];
+  uint32_t head = dev->reaped + (uint16_t)(head16 - (uint16_t)dev->reaped);
+
+  for (; dev->reaped != head; dev->reaped++) {
+    unsigned int slot = dev->reaped % BM4_SLOTS;
+    volatile uint32_t *c = dev->ring + slot * 4;
+    if (c[CPL_DESC] != dev->desc_phys + slot * DESC_WORDS * 4)
+      fprintf(stderr, "Warning: ring entry %u is for 0x%08X\n", dev->reaped,
+              c[CPL_DESC]);
+    dev->cpl_status[slot] = c[CPL_STATUS];
+  }
+  dev->csr[REG_CQ_TAIL] = head16;
+}
+
+static int ticket_done(bm4_dev_t *dev, uint32_t ticket) {
+  return (int32_t)(dev->reaped - ticket) > 0;
+}
+
+int bm4_poll(bm4_dev_t *dev, uint32_t ticket) {
+  bm4_reap(dev);
+  return ticket_done(dev, ticket);
+}
+
+int bm4_wait(bm4_dev_t *dev, uint32_t ticket, int timeout_ms) {
+  for (;;) {
+    // Clear Done before looking at the ring, so a command that finishes after
+    // the check still raises the IRQ we are about to sleep on
+    dev->csr[REG_STATUS] = 1;
+    bm4_reap(dev);
+    if (ticket_done(dev, ticket)) {
+      // Only valid until BM4_SLOTS newer tickets have completed
+      uint32_t status = dev->cpl_status[ticket % BM4_SLOTS];
+      return (status & CPL_DONE) ? (int)(status & ~CPL_DONE) : -1;
+    }
+
+    uint32_t info = 1;
+    if (write(dev->fd, &info, sizeof(info)) != sizeof(info)) {
+      perror("Error: UIO irq enable");
+      return -1;
+    }
+    struct pollfd pfd = {.fd = dev->fd, .events = POLLIN};
+    if (poll(&pfd, 1, timeout_ms) <= 0) {
+      fprintf(stderr, "Error: no DMA interrupt within %d ms\n", timeout_ms);
+      return -1;
+    }
+    if (read(dev->fd, &info, sizeof(info)) != sizeof(info)) {
+      perror("Error: UIO read");
+      return -1;
+    }
+  }
+}
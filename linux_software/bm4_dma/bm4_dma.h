@@ -0,0 +1,68 @@
+// Burst Master 4 user-space DMA library (Linux, lightweight bridge + UIO)
+//
+// Copies between physically contiguous buffers through the burst_master_4
+// command queue. Each copy is one descriptor pushed with a single CSR write;
+// completions land in a ring in the control buffer, and waiting sleeps on the
+// UIO interrupt instead of spinning on the CSR.
+//
+// Buffers come from u-dma-buf (/dev/udmabufN, CMA-backed) or, without that
+// driver, from the reserved region above mem=512M through /dev/mem. Both are
+// mapped with O_SYNC, so CPU writes need no cache maintenance before a submit.
+//
+// One thread submits and waits; add a lock if several threads share a device.
+
+#ifndef BM4_DMA_H_
+#define BM4_DMA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define BM4_SLOTS 16 // Commands in flight (command queue depth)
+#define BM4_CTL_BYTES 4096 // Descriptors + completion ring
+
+typedef struct {
+  void *virt;
+  uint32_t phys;
+  size_t size;
+  int fd;
+  void *map;       // Page-aligned mapping behind virt
+  size_t map_size;
+} bm4_buf_t;
+
+typedef struct {
+  int fd; // /dev/uioN
+  volatile uint32_t *csr;
+  void *map;
+  size_t map_size;
+  volatile uint32_t *desc; // BM4_SLOTS x 16 words
+  volatile uint32_t *ring; // BM4_SLOTS x 4 words
+  uint32_t desc_phys, ring_phys;
+  uint32_t submitted; // Tickets handed out
+  uint32_t reaped;    // Completions read from the ring
+  uint32_t cpl_status[BM4_SLOTS]; // Ring STATUS word per slot
+} bm4_dev_t;
+
+// u-dma-buf device by name ("udmabuf0"); address and size come from sysfs
+int bm4_buf_open(bm4_buf_t *buf, const char *name);
+// Physical range through /dev/mem (e.g. the reserved region at 0x20000000)
+int bm4_buf_map(bm4_buf_t *buf, uint32_t phys, size_t size);
+void bm4_buf_close(bm4_buf_t *buf);
+
+// Physical address of UIO map 0 ("/dev/uioN" or "uioN"), 0 if unknown. The
+// CSR may not start on a page boundary, so callers add its page offset.
+unsigned long bm4_uio_map_addr(const char *uio);
+
+// Takes BM4_CTL_BYTES at ctl->virt + ctl_off for descriptors and the ring
+int bm4_open(bm4_dev_t *dev, const char *uio, bm4_buf_t *ctl, size_t ctl_off);
+void bm4_close(bm4_dev_t *dev);
+
+// Queues dst <- src (physical, SRC[1:0] == DST[1:0]). Returns 0 and a ticket,
+// or -1 with errno = EAGAIN when BM4_SLOTS copies are already in flight.
+int bm4_submit_copy(bm4_dev_t *dev, uint32_t dst, uint32_t src, uint32_t len,
+                    uint32_t *ticket);
+// 1 if the ticket has completed, 0 if not
+int bm4_poll(bm4_dev_t *dev, uint32_t ticket);
+// Sleeps until the ticket completes; returns bytes moved or -1 on timeout
+int bm4_wait(bm4_dev_t *dev, uint32_t ticket, int timeout_ms);
+
+#endif /* BM4_DMA_H_ */
@@ -0,0 +1,118 @@
+// Burst Master 4 fill with interrupt-driven completion (UIO)
+//
+// The device tree exposes burst_master_4_0 as a generic-uio node, so
+// uio_pdrv_genirq owns its IRQ (boot with uio_pdrv_genirq.of_id=generic-uio).
+// read() on /dev/uioN sleeps until Done, instead of spinning on STATUS.
+//
+// Usage: dma_uio [color] [/dev/uioN]
+//   Fills the 960x540 frame buffer at 0x30000000 with one color.
+
+#include "bm4_dma.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#define FRAME_BUFFER_BASE 0x30000000
+#define FRAME_WIDTH 960
+#define FRAME_HEIGHT 540
+
+// Burst Master 4 CSR (word offsets)
+#define REG_CTRL 0
+#define REG_STATUS 1
+#define REG_DST_ADDR 3
+#define REG_LEN 4
+#define REG_WR_BURST 6
+#define REG_HEIGHT 13
+#define REG_DST_STRIDE 15
+#define REG_FILL 16
+#define REG_FILL_PAT0 17
+#define REG_IRQ_EN 39
+
+#define CTRL_START (1 << 0)
+#define FILL_OFF 0
+#define FILL_CONST 1
+#define IRQ_EN_DONE (1 << 0)
+
+#define IRQ_TIMEOUT_MS 1000
+
+// Unmask the IRQ in the kernel, then sleep until it fires
+static int uio_wait_irq(int fd) {
+  uint32_t info = 1;
+  if (write(fd, &info, sizeof(info)) != sizeof(info)) {
+    perror("Error: UIO irq enable");
+    return -1;
+  }
+
+  struct pollfd pfd = {.fd = fd, .events = POLLIN};
+  int ret = poll(&pfd, 1, IRQ_TIMEOUT_MS);
+  if (ret <= 0) {
+    fprintf(stderr, "Error: no DMA interrupt within %d ms\n", IRQ_TIMEOUT_MS);
+    return -1;
+  }
+  if (read(fd, &info, sizeof(info)) != sizeof(info)) {
+    perror("Error: UIO read");
+    return -1;
+  }
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  uint32_t color = (argc > 1) ? strtoul(argv[1], NULL, 0) : 0x00202020;
+  const char *dev = (argc > 2) ? argv[2] : "/dev/uio0";
+
+  int fd = open(dev, O_RDWR);
+  if (fd == -1) {
+    perror("Error: could not open UIO device");
+    return 1;
+  }
+
+  long page = sysconf(_SC_PAGESIZE);
+  void *map = mmap(NULL, page, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (map == MAP_FAILED) {
+    perror("Error: mmap() failed");
+    close(fd);
+    return 1;
+  }
+  volatile uint32_t *csr =
+      (volatile uint32_t *)((uint8_t *)map + (bm4_uio_map_addr(dev) & (page - 1)));
+
+  // A stale Done would hold the level IRQ high
+  csr[REG_STATUS] = 1;
+  csr[REG_IRQ_EN] = IRQ_EN_DONE;
+
+  csr[REG_FILL_PAT0] = color;
+  csr[REG_FILL] = FILL_CONST;
+  csr[REG_DST_ADDR] = FRAME_BUFFER_BASE;
+  csr[REG_LEN] = FRAME_WIDTH * 4;
+  csr[REG_HEIGHT] = FRAME_HEIGHT;
+  csr[REG_DST_STRIDE] = FRAME_WIDTH * 4;
+  csr[REG_WR_BURST] = 64;
+
+  struct timespec t0, t1;
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  csr[REG_CTRL] = CTRL_START;
+  int ret = uio_wait_irq(fd);
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+
+  // Drop Done (and the IRQ line) before the next job
+  csr[REG_STATUS] = 1;
+  csr[REG_FILL] = FILL_OFF;
+  csr[REG_HEIGHT] = 0;
+
+  if (ret == 0) {
+    long us = (t1.tv_sec - t0.tv_sec) * 1000000L +
+              (t1.tv_nsec - t0.tv_nsec) / 1000L;
+    printf("Filled %dx%d with 0x%08X in %ld us (IRQ)\n", FRAME_WIDTH,
+           FRAME_HEIGHT, color, us);
+  }
+
+  munmap(map, page);
+  close(fd);
+  return ret == 0 ? 0 : 1;
+}
@@ -1,39 +1,73 @@
+import argparse
 import sys
 import os
 from PIL import Image
+from vfc import VfcWriter, FMT_XRGB32
 
-def convert_image_to_raw(input_path, output_path):
-    # Target Resolution 540p
-    WIDTH = 960
-    HEIGHT = 540
+WIDTH = 960
+HEIGHT = 540
+
+
+def image_to_xrgb(input_path):
+    # Open and Resize Image (Target Resolution 540p)
+    img = Image.open(input_path)
+    img = img.resize((WIDTH, HEIGHT), Image.Resampling.LANCZOS)
+
+    # Ensure RGB format
+    img = img.convert('RGB')
+
+    print(f"Converting {input_path} ({img.size})...")
 
+    data = bytearray()
+    for y in range(HEIGHT):
+        for x in range(WIDTH):
+            r, g, b = img.getpixel((x, y))
+            # Format: 32-bit XRGB (0x00RRGGBB)
+            # Lower 24 bits are used in our hardware (hdmi_sync_gen.v)
+            data += bytes([b, g, r, 0x00]) # Little Endian for ARM/Nios
+    return data
+
+
+def convert_image_to_raw(input_path, output_path):
     try:
-        # Open and Resize Image
-        img = Image.open(input_path)
-        img = img.resize((WIDTH, HEIGHT), Image.Resampling.LANCZOS)
-        
-        # Ensure RGB format
-        img = img.convert('RGB')
-        
-        print(f"Converting {input_path} ({img.size}) to {output_path}...")
-        
         with open(output_path, 'wb') as f:
-            for y in range(HEIGHT):
-                for x in range(WIDTH):
-                    r, g, b = img.getpixel((x, y))
-                    # Format: 32-bit XRGB (0x00RRGGBB)
-                    # Lower 24 bits are used in our hardware (hdmi_sync_gen.v)
-                    pixel_data = bytearray([b, g, r, 0x00]) # Little Endian for ARM/Nios
-                    f.write(pixel_data)
-                    
+            f.write(image_to_xrgb(input_path))
+
         print(f"Successfully created {output_path} ({os.path.getsize(output_path)} bytes)")
 
     except Exception as e:
         print(f"Error: {e}")
 
+
+def convert_images_to_vfc(input_paths, output_path, fps, stripe_lines=0):
+    # One frame per image, in order (see vfc.py for the layout)
+    try:
+        w = VfcWriter(output_path, WIDTH, HEIGHT, WIDTH * 4, FMT_XRGB32, (fps, 1), len(input_paths),
+                      stripe_lines)
+        for path in input_paths:
+            w.add_frame(image_to_xrgb(path))
+        w.close()
+
+        print(f"Successfully created {output_path} ({len(input_paths)} frames, "
+              f"{os.path.getsize(output_path)} bytes)")
+
+    except Exception as e:
+        print(f"Error: {e}")
+
+
 if __name__ == "__main__":
-    if len(sys.argv) < 3:
-        print("Usage: python img2raw.py <input_image> <output_raw>")
+    parser = argparse.ArgumentParser(description="Convert images to 960x540 XRGB frames")
+    parser.add_argument("inputs", nargs="+", help="Input image(s)")
+    parser.add_argument("output", help="Headerless .raw (one image) or .vfc container")
+    parser.add_argument("--fps", type=int, default=60, help="Frame rate stored in a .vfc")
+    parser.add_argument("--stripe", type=int, default=0, metavar="LINES",
+                        help="LZ4-compress .vfc frames in stripes of LINES lines (e.g. 68)")
+    args = parser.parse_args()
+
+    if args.output.endswith(".vfc"):
+        convert_images_to_vfc(args.inputs, args.output, args.fps, args.stripe)
+    elif len(args.inputs) == 1:
+        convert_image_to_raw(args.inputs[0], args.output)
+    else:
+        print("Error: several images need a .vfc output")
         sys.exit(1)
-        
-    convert_image_to_raw(sys.argv[1], sys.argv[2])
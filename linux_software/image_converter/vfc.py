@@ -0,0 +1,188 @@
+"""VFC container writer / reader (layout: linux_software/video_player/vfc.h)"""
+import mmap
+import struct
+
+try:
+    import lz4.block as _lz4
+except ImportError:  # Fall back to the (slow) pure-Python encoder below
+    _lz4 = None
+
+VFC_MAGIC = 0x31434656  # "VFC1"
+VFC_VERSION = 1
+VFC_ALIGN = 4096
+FMT_XRGB32, FMT_RGB888, FMT_RGB565, FMT_YUYV, FMT_I420 = 0, 1, 2, 3, 4
+FLAG_LZ4 = 1 << 0
+
+HEADER = struct.Struct("<IHHIIIIIIIIII16x")  # 64 bytes
+INDEX = struct.Struct("<QII")                # 16 bytes
+
+# Headerless .raw files from older img2raw.py
+RAW_WIDTH, RAW_HEIGHT, RAW_FPS = 960, 540, 60
+Y4M_MAGIC = b"YUV4MPEG2 "
+Y4M_FRAME = b"FRAME\n"
+
+
+def align(n):
+    return (n + VFC_ALIGN - 1) // VFC_ALIGN * VFC_ALIGN
+
+
+def _lz4_length(n):
+    out = bytearray()
+    while n >= 255:
+        out.append(255)
+        n -= 255
+    out.append(n)
+    return out
+
+
+def lz4_compress_block(data):
+    """Raw LZ4 block (no size prefix), decodable by lz4_block.c."""
+    if _lz4:
+        return _lz4.compress(data, store_size=False)
+    # Greedy single-entry hash of 4-byte sequences. Format rules: the last 5
+    # bytes are literals and no match starts within the last 12 bytes.
+    n = len(data)
+    out = bytearray()
+    table = {}
+    anchor = i = 0
+    while i < n - 12:
+        key = data[i:i + 4]
+        cand = table.get(key)
+        table[key] = i
+        if cand is None or i - cand > 0xFFFF:
+            i += 1
+            continue
+        length = 4
+        limit = n - 5 - i
+        while length < limit and data[cand + length] == data[i + length]:
+            length += 1
+        lit = i - anchor
+        ml = length - 4
+        out.append((min(lit, 15) << 4) | min(ml, 15))
+        if lit >= 15:
+            out += _lz4_length(lit - 15)
+        out += data[anchor:i]
+        out += struct.pack("<H", i - cand)
+        if ml >= 15:
+            out += _lz4_length(ml - 15)
+        i += length
+        anchor = i
+    lit = n - anchor
+    out.append(min(lit, 15) << 4)
+    if lit >= 15:
+        out += _lz4_length(lit - 15)
+    out += data[anchor:]
+    return bytes(out)
+
+
+class VfcWriter:
+    """Writes frames in order; the index is reserved for `capacity` frames.
+
+    With stripe_lines, each frame is stored as independent LZ4 stripes unless
+    that would not make it smaller.
+    """
+
+    def __init__(self, path, width, height, stride, fmt=FMT_XRGB32, fps=(60, 1), capacity=1,
+                 stripe_lines=0):
+        self.f = open(path, "wb")
+        self.width, self.height, self.stride, self.fmt, self.fps = width, height, stride, fmt, fps
+        self.capacity = capacity
+        self.stripe_lines = stripe_lines
+        self.index = []
+        self.pos = align(VFC_ALIGN + capacity * INDEX.size)
+
+    def add_frame(self, payload):
+        if len(self.index) == self.capacity:
+            raise ValueError(f"Index is full ({self.capacity} frames)")
+        frame_bytes = self.frame_bytes()
+        if len(payload) != frame_bytes:
+            raise ValueError(f"Frame is {len(payload)} bytes, expected {frame_bytes}")
+        flags = 0
+        if self.stripe_lines:
+            step = self.stripe_lines * self.stride
+            blocks = [lz4_compress_block(payload[i:i + step]) for i in range(0, len(payload), step)]
+            packed = struct.pack(f"<{len(blocks)}I", *map(len, blocks)) + b"".join(blocks)
+            if len(packed) < len(payload):
+                payload, flags = packed, FLAG_LZ4
+        self.f.seek(self.pos)
+        self.f.write(payload)
+        self.index.append((self.pos, len(payload), flags))
+        self.pos = align(self.pos + len(payload))
+
+    def frame_bytes(self):
+        # I420: stride is the luma stride, U and V planes follow at half size
+        return self.stride * self.height * (3 if self.fmt == FMT_I420 else 2) // 2
+
+    def close(self):
+        self.f.seek(0)
+        self.f.write(HEADER.pack(VFC_MAGIC, VFC_VERSION, HEADER.size, self.width, self.height,
+                                 self.stride, self.fmt, self.fps[0], self.fps[1], len(self.index),
+                                 self.frame_bytes(), VFC_ALIGN, self.stripe_lines))
+        self.f.seek(VFC_ALIGN)
+        for entry in self.index:
+            self.f.write(INDEX.pack(*entry))
+        # Pad the last payload so every frame can be mapped as whole pages
+        self.f.truncate(self.pos)
+        self.f.close()
+
+
+class VfcReader:
+    """Reads a .vfc container, a Y4M 4:2:0 stream or a headerless .raw file.
+
+    Same rules as vfc_file.c; frames are memoryviews into a read-only mmap.
+    """
+
+    def __init__(self, path):
+        self.f = open(path, "rb")
+        self.data = mmap.mmap(self.f.fileno(), 0, access=mmap.ACCESS_READ)
+        data = self.data
+        self.stripe_lines = 0
+        if len(data) >= VFC_ALIGN and struct.unpack_from("<I", data)[0] == VFC_MAGIC:
+            (_, _, _, self.width, self.height, self.stride, self.fmt, fps_num, fps_den, count,
+             self.frame_bytes, index_offset, self.stripe_lines) = HEADER.unpack_from(data)
+            self.index = [INDEX.unpack_from(data, index_offset + n * INDEX.size)
+                          for n in range(count)]
+        elif data[:len(Y4M_MAGIC)] == Y4M_MAGIC:
+            end = data.find(b"\n", 0, 512)
+            if end < 0:
+                raise ValueError("Y4M header line is not terminated")
+            fields = {t[:1]: t[1:] for t in data[len(Y4M_MAGIC):end].decode().split()}
+            if fields.get("C", "420") not in ("420", "420jpeg", "420paldv", "420mpeg2"):
+                raise ValueError(f"Y4M colorspace C{fields['C']}, only 4:2:0 is supported")
+            self.width, self.height = int(fields["W"]), int(fields["H"])
+            fps_num, fps_den = map(int, fields.get("F", "30:1").split(":"))
+            self.stride, self.fmt = self.width, FMT_I420
+            self.frame_bytes = self.width * self.height * 3 // 2
+            step = len(Y4M_FRAME) + self.frame_bytes
+            first = end + 1 + len(Y4M_FRAME)
+            if data[end + 1:first] != Y4M_FRAME:
+                raise ValueError("Y4M frames must start with a plain FRAME")
+            count = (len(data) - end - 1) // step
+            self.index = [(first + n * step, self.frame_bytes, 0) for n in range(count)]
+        else:
+            self.width, self.height, self.stride = RAW_WIDTH, RAW_HEIGHT, RAW_WIDTH * 4
+            self.fmt, fps_num, fps_den = FMT_XRGB32, RAW_FPS, 1
+            self.frame_bytes = self.stride * self.height
+            count = len(data) // self.frame_bytes
+            self.index = [(n * self.frame_bytes, self.frame_bytes, 0) for n in range(count)]
+        self.fps = (fps_num, fps_den)
+        if not self.index:
+            raise ValueError(f"{path} holds no frames")
+
+    def __len__(self):
+        return len(self.index)
+
+    def header(self):
+        """The file's header as a VFC header without an index."""
+        return HEADER.pack(VFC_MAGIC, VFC_VERSION, HEADER.size, self.width, self.height,
+                           self.stride, self.fmt, self.fps[0], self.fps[1], len(self.index),
+                           self.frame_bytes, 0, self.stripe_lines)
+
+    def frame(self, n):
+        """(payload, flags) of frame n; release the payload view before close()."""
+        offset, size, flags = self.index[n]
+        return memoryview(self.data)[offset:offset + size], flags
+
+    def close(self):
+        self.data.close()
+        self.f.close()
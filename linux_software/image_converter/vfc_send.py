@@ -0,0 +1,96 @@
+"""Streams a .vfc, .y4m or .raw file to video_player / vfc_recv over TCP or UDP.
+
+Wire format: linux_software/video_player/vfc_net.h
+"""
+import argparse
+import socket
+import struct
+import sys
+import time
+from vfc import VfcReader
+
+NET_MAGIC = 0x4E434656  # "VFCN"
+NET_PORT = 5000
+CHUNK = struct.Struct("<IIIIII")  # magic, seq, bytes, flags, offset, length
+MAX_CHUNK = 65507 - CHUNK.size    # Largest UDP payload
+
+
+def send_frame(sock, udp, chunk, seq, payload, flags):
+    if not udp:
+        sock.sendall(CHUNK.pack(NET_MAGIC, seq, len(payload), flags, 0, len(payload)))
+        sock.sendall(payload)
+        return
+    for offset in range(0, len(payload), chunk):
+        piece = payload[offset:offset + chunk]
+        sock.sendmsg([CHUNK.pack(NET_MAGIC, seq, len(payload), flags, offset, len(piece)), piece])
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Stream video frames to the board")
+    parser.add_argument("file", help=".vfc, .y4m or headerless .raw")
+    parser.add_argument("host", help="Board address")
+    parser.add_argument("--port", type=int, default=NET_PORT)
+    parser.add_argument("--udp", action="store_true", help="UDP instead of TCP")
+    parser.add_argument("--chunk", type=int, default=8192,
+                        help="UDP data bytes per datagram (1448 avoids IP fragmentation)")
+    parser.add_argument("--fps", type=float, help="Override the file's rate; 0 = as fast as possible")
+    parser.add_argument("--loop", action="store_true", help="Repeat until interrupted")
+    args = parser.parse_args()
+    if not 0 < args.chunk <= MAX_CHUNK:
+        parser.error(f"--chunk must be 1..{MAX_CHUNK}")
+
+    r = VfcReader(args.file)
+    fps = args.fps if args.fps is not None else r.fps[0] / r.fps[1]
+    header = r.header()
+
+    if args.udp:
+        sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        sock.connect((args.host, args.port))
+    else:
+        sock = socket.create_connection((args.host, args.port))
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_SNDBUF, 4 << 20)
+    if not args.udp:
+        sock.sendall(header)
+
+    print(f"Sending {args.file}: {len(r)} frames, {r.width}x{r.height} format {r.fmt}, "
+          f"{fps:g} fps over {'UDP' if args.udp else 'TCP'}")
+    # Absolute deadlines, like the player; the receiver shows frames on arrival
+    start = next_time = last_report = time.perf_counter()
+    seq = sent = 0
+    try:
+        while True:
+            for n in range(len(r)):
+                # A late-joining UDP receiver needs the header; repeat it once a second
+                if args.udp and seq % max(1, round(fps) or 60) == 0:
+                    sock.send(header)
+                payload, flags = r.frame(n)
+                send_frame(sock, args.udp, args.chunk, seq, payload, flags)
+                sent += len(payload)
+                payload.release()
+                seq += 1
+
+                if fps > 0:
+                    next_time += 1 / fps
+                    delay = next_time - time.perf_counter()
+                    if delay > 0:
+                        time.sleep(delay)
+                now = time.perf_counter()
+                if now - last_report >= 1:
+                    print(f"frame {seq}: {sent / 1e6 / (now - start):.1f} MB/s")
+                    last_report = now
+            if not args.loop:
+                break
+    except KeyboardInterrupt:
+        pass
+    except OSError as e:
+        print(f"Error: {e}")
+        sys.exit(1)
+    finally:
+        sock.close()
+
+    elapsed = time.perf_counter() - start
+    print(f"Sent {seq} frames, {sent / 1e6:.1f} MB in {elapsed:.1f} s")
+
+
+if __name__ == "__main__":
+    main()
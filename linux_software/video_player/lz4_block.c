@@ -0,0 +1,64 @@
+#include "lz4_block.h"
+
+#include <string.h>
+
+// Sequence: token [lit_len+] literals offset(16, LE) [match_len+]
+// Token high nibble = literal length, low nibble = match length - 4; 15 means
+// more length bytes follow (255 = keep going). The last sequence has no match.
+
+static int read_len(const uint8_t **ip, const uint8_t *iend, size_t *len) {
+  unsigned int b;
+  do {
+    if (*ip >= iend)
+      return -1;
+    b = *(*ip)++;
+    *len += b;
+  } while (b == 255);
+  return 0;
+}
+
+long lz4_decode_block(const uint8_t *src, size_t src_len, uint8_t *dst,
+                      size_t dst_len) {
+  const uint8_t *ip = src, *iend = src + src_len;
+  uint8_t *op = dst, *oend = dst + dst_len;
+
+  while (ip < iend) {
+    unsigned int token = *ip++;
+
+    size_t lit = token >> 4;
+    if (lit == 15 && read_len(&ip, iend, &lit))
+      return -1;
+    if (lit > (size_t)(iend - ip) || lit > (size_t)(oend - op))
+      return -1;
+    memcpy(op, ip, lit);
+    ip += lit;
+    op += lit;
+    if (ip == iend)
+      break; // Last sequence: literals only
+
+    if (iend - ip < 2)
+      return -1;
+    size_t offset = ip[0] | (ip[1] << 8);
+    ip += 2;
+    if (offset == 0 || offset > (size_t)(op - dst))
+      return -1;
+
+    size_t len = token & 15;
+    if (len == 15 && read_len(&ip, iend, &len))
+      return -1;
+    len += 4;
+    if (len > (size_t)(oend - op))
+      return -1;
+
+    const uint8_t *match = op - offset;
+    if (offset >= len) {
+      memcpy(op, match, len);
+      op += len;
+    } else {
+      // Overlapping match repeats the last `offset` bytes (runs, patterns)
+      while (len--)
+        *op++ = *match++;
+    }
+  }
+  return op - dst;
+}
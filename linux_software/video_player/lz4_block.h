@@ -0,0 +1,14 @@
+// LZ4 block format decoder (no frame header, no checksums)
+
+#ifndef LZ4_BLOCK_H_
+#define LZ4_BLOCK_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Decodes one block; returns the bytes written to dst, or -1 if the block is
+// malformed or would overrun dst
+long lz4_decode_block(const uint8_t *src, size_t src_len, uint8_t *dst,
+                      size_t dst_len);
+
+#endif /* LZ4_BLOCK_H_ */
@@ -0,0 +1,66 @@
+// VFC: self-describing video frame container
+//
+//   0x0000  vfc_header_t (64 bytes, rest of the page zero)
+//   0x1000  vfc_index_t[frame_count], padded to a page
+//   ...     Frame payloads, each starting on a 4 KB boundary
+//
+// With stripe_lines != 0, a frame may be stored compressed (VFC_FLAG_LZ4):
+// the frame is cut into stripes of stripe_lines lines (the last may be
+// shorter), and each stripe is an independent LZ4 block, so stripes can be
+// decoded in parallel. The payload is
+//   uint32_t size[stripes]   Compressed bytes of each stripe
+//   ...                      The blocks, back to back
+// Frames that do not compress are stored raw with flags = 0.
+//
+// All fields are little-endian. A player mmaps the file and finds frame n at
+// base + index[n].offset without parsing anything else. Writers may reserve a
+// larger index than frame_count (unused entries stay zero).
+// The Python writer is linux_software/image_converter/vfc.py.
+
+#ifndef VFC_H_
+#define VFC_H_
+
+#include <stdint.h>
+
+#define VFC_MAGIC 0x31434656 // "VFC1"
+#define VFC_VERSION 1
+#define VFC_ALIGN 4096
+
+// Same numbers as the burst_master_4 FMT register
+#define VFC_FMT_XRGB32 0 // B G R X
+#define VFC_FMT_RGB888 1
+#define VFC_FMT_RGB565 2
+#define VFC_FMT_YUYV 3
+// Planar Y, U, V 4:2:0 (stride = luma stride); no hardware equivalent, the
+// HPS converts it
+#define VFC_FMT_I420 4
+
+#define VFC_FLAG_LZ4 (1 << 0) // Payload is LZ4 stripes
+
+typedef struct {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t header_bytes; // sizeof(vfc_header_t)
+  uint32_t width;
+  uint32_t height;
+  uint32_t stride; // Bytes per line
+  uint32_t pixel_format;
+  uint32_t fps_num;
+  uint32_t fps_den;
+  uint32_t frame_count;
+  uint32_t frame_bytes;  // stride * height (* 3 / 2 for VFC_FMT_I420)
+  uint32_t index_offset; // VFC_ALIGN
+  uint32_t stripe_lines; // Lines per LZ4 stripe, 0 = no compressed frames
+  uint32_t reserved[4];
+} vfc_header_t;
+
+typedef struct {
+  uint64_t offset; // From the start of the file, multiple of VFC_ALIGN
+  uint32_t bytes;  // Payload size
+  uint32_t flags;  // VFC_FLAG_*
+} vfc_index_t;
+
+_Static_assert(sizeof(vfc_header_t) == 64, "vfc_header_t layout");
+_Static_assert(sizeof(vfc_index_t) == 16, "vfc_index_t layout");
+
+#endif /* VFC_H_ */
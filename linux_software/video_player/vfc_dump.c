@@ -0,0 +1,75 @@
+// VFC container dump and validation
+//
+// Prints the header and (with -v) the frame index, then checks every field.
+// Exit status is 0 only if the file is a valid container (or Y4M stream).
+//
+// Usage: vfc_dump <file.vfc | file.y4m> [-v]
+
+#include "vfc_file.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static const char *const fmt_names[] = {"XRGB32", "RGB888", "RGB565", "YUYV",
+                                        "I420"};
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    printf("Usage: %s <file.vfc | file.y4m> [-v]\n", argv[0]);
+    return 1;
+  }
+  int verbose = (argc > 2) && strcmp(argv[2], "-v") == 0;
+
+  vfc_file_t v;
+  if (vfc_map(&v, argv[1]) != 0)
+    return 1;
+  const vfc_header_t *h = &v.hdr;
+
+  int y4m = !v.index && h->pixel_format == VFC_FMT_I420;
+  if (!v.index && !y4m) {
+    printf("%s: no VFC header (headerless raw, %zu bytes)\n", argv[1], v.size);
+    vfc_close(&v);
+    return 1;
+  }
+
+  printf("%s: %zu bytes%s\n", argv[1], v.size, y4m ? " (Y4M)" : "");
+  printf("  version      %u (header %u bytes)\n", h->version, h->header_bytes);
+  printf("  size         %u x %u, stride %u\n", h->width, h->height, h->stride);
+  printf("  format       %u (%s)\n", h->pixel_format,
+         h->pixel_format <= VFC_FMT_I420 ? fmt_names[h->pixel_format] : "?");
+  printf("  fps          %u/%u\n", h->fps_num, h->fps_den);
+  printf("  frames       %u x %u bytes\n", h->frame_count, h->frame_bytes);
+  if (y4m) {
+    printf("  frame data   0x%zX, every %zu bytes\n", v.data_offset,
+           v.frame_step);
+  } else {
+    printf("  index        0x%X\n", h->index_offset);
+    printf("  stripes      %u lines%s\n", h->stripe_lines,
+           h->stripe_lines ? "" : " (uncompressed)");
+  }
+
+  fflush(stdout); // Errors go to stderr, keep them after the header
+  int errors = vfc_validate(&v, 20);
+  if (errors == 0 && v.index) {
+    uint64_t stored = 0;
+    uint32_t lz4 = 0;
+    for (uint32_t n = 0; n < h->frame_count; n++) {
+      const vfc_index_t *e = &v.index[n];
+      stored += e->bytes;
+      lz4 += (e->flags & VFC_FLAG_LZ4) != 0;
+      if (verbose)
+        printf("  [%5u] 0x%010llX %u bytes%s\n", n,
+               (unsigned long long)e->offset, e->bytes,
+               (e->flags & VFC_FLAG_LZ4) ? " LZ4" : "");
+    }
+    if (h->stripe_lines)
+      printf("  compressed   %u of %u frames, %.1f%% of raw size\n", lz4,
+             h->frame_count,
+             100.0 * stored / ((uint64_t)h->frame_count * h->frame_bytes));
+  }
+
+  printf("%s: %d error%s\n", errors ? "INVALID" : "OK", errors,
+         errors == 1 ? "" : "s");
+  vfc_close(&v);
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,262 @@
+#include "vfc_file.h"
+#include "lz4_block.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const uint32_t vfc_bpp[] = {4, 3, 2, 2, 1}; // Per VFC_FMT_*
+
+#define Y4M_MAGIC "YUV4MPEG2 "
+#define Y4M_FRAME "FRAME\n"
+#define Y4M_FRAME_LEN 6
+
+static int y4m_token_is(const char *tok, size_t len, const char *s) {
+  return len == strlen(s) && memcmp(tok, s, len) == 0;
+}
+
+// "YUV4MPEG2 W960 H540 F60:1 Ip A1:1 C420jpeg\n", then "FRAME\n" + Y + U + V
+// per frame. Only 4:2:0 8-bit without per-frame parameters is accepted, so
+// every frame is the same size and can be found without scanning.
+static int y4m_parse(vfc_file_t *v) {
+  vfc_header_t *h = &v->hdr;
+  const char *p = (const char *)v->base;
+  const char *end = memchr(p, '\n', v->size < 512 ? v->size : 512);
+  if (!end) {
+    fprintf(stderr, "Error: Y4M header line is not terminated\n");
+    return -1;
+  }
+
+  for (p += strlen(Y4M_MAGIC); p < end;) {
+    const char *tok = p;
+    while (p < end && *p != ' ')
+      p++;
+    size_t len = p++ - tok;
+    if (len == 0)
+      continue;
+    // Numbers stop at the following space or newline
+    if (*tok == 'W')
+      h->width = strtoul(tok + 1, NULL, 10);
+    else if (*tok == 'H')
+      h->height = strtoul(tok + 1, NULL, 10);
+    else if (*tok == 'F')
+      sscanf(tok + 1, "%u:%u", &h->fps_num, &h->fps_den);
+    else if (*tok == 'C' && !y4m_token_is(tok, len, "C420") &&
+             !y4m_token_is(tok, len, "C420jpeg") &&
+             !y4m_token_is(tok, len, "C420paldv") &&
+             !y4m_token_is(tok, len, "C420mpeg2")) {
+      fprintf(stderr, "Error: Y4M colorspace %.*s, only 4:2:0 is supported\n",
+              (int)len, tok);
+      return -1;
+    }
+  }
+  if (h->width == 0 || h->height == 0 || (h->width | h->height) & 1) {
+    fprintf(stderr, "Error: Y4M frame %ux%u, 4:2:0 needs an even size\n",
+            h->width, h->height);
+    return -1;
+  }
+
+  h->magic = VFC_MAGIC;
+  h->version = VFC_VERSION;
+  h->header_bytes = sizeof(vfc_header_t);
+  h->stride = h->width;
+  h->pixel_format = VFC_FMT_I420;
+  h->frame_bytes = h->width * h->height / 2 * 3;
+  v->frame_step = Y4M_FRAME_LEN + h->frame_bytes;
+  v->data_offset = (end + 1 - (const char *)v->base) + Y4M_FRAME_LEN;
+  h->frame_count = (v->size - v->data_offset + Y4M_FRAME_LEN) / v->frame_step;
+
+  // Frame parameters would shift every later frame; the last one shows it
+  uint32_t check[2] = {0, h->frame_count - 1};
+  for (int i = 0; i < 2 && h->frame_count; i++) {
+    if (memcmp(vfc_frame(v, check[i]) - Y4M_FRAME_LEN, Y4M_FRAME,
+               Y4M_FRAME_LEN)) {
+      fprintf(stderr, "Error: Y4M frame %u does not start with a plain FRAME\n",
+              check[i]);
+      return -1;
+    }
+  }
+  return 0;
+}
+
+int vfc_map(vfc_file_t *v, const char *path) {
+  struct stat st;
+
+  memset(v, 0, sizeof(*v));
+  v->fd = open(path, O_RDONLY);
+  if (v->fd == -1) {
+    perror("Error: could not open video file");
+    return -1;
+  }
+  if (fstat(v->fd, &st) != 0 || st.st_size == 0) {
+    fprintf(stderr, "Error: %s is empty\n", path);
+    close(v->fd);
+    return -1;
+  }
+  v->size = st.st_size;
+  v->base = mmap(NULL, v->size, PROT_READ, MAP_SHARED, v->fd, 0);
+  if (v->base == MAP_FAILED) {
+    perror("Error: mmap() failed");
+    close(v->fd);
+    return -1;
+  }
+
+  if (v->size >= VFC_ALIGN && ((const vfc_header_t *)v->base)->magic == VFC_MAGIC) {
+    memcpy(&v->hdr, v->base, sizeof(v->hdr));
+    v->index = (const vfc_index_t *)(v->base + v->hdr.index_offset);
+  } else if (v->size > strlen(Y4M_MAGIC) &&
+             memcmp(v->base, Y4M_MAGIC, strlen(Y4M_MAGIC)) == 0) {
+    if (y4m_parse(v) != 0) {
+      vfc_close(v);
+      return -1;
+    }
+  } else {
+    v->hdr.magic = VFC_MAGIC;
+    v->hdr.version = VFC_VERSION;
+    v->hdr.header_bytes = sizeof(vfc_header_t);
+    v->hdr.width = VFC_RAW_WIDTH;
+    v->hdr.height = VFC_RAW_HEIGHT;
+    v->hdr.stride = VFC_RAW_WIDTH * 4;
+    v->hdr.pixel_format = VFC_FMT_XRGB32;
+    v->hdr.fps_num = VFC_RAW_FPS;
+    v->hdr.fps_den = 1;
+    v->hdr.frame_bytes = v->hdr.stride * VFC_RAW_HEIGHT;
+    v->hdr.frame_count = v->size / v->hdr.frame_bytes;
+    v->frame_step = v->hdr.frame_bytes;
+  }
+  return 0;
+}
+
+int vfc_open(vfc_file_t *v, const char *path) {
+  if (vfc_map(v, path) != 0)
+    return -1;
+  if (vfc_validate(v, 1) != 0) {
+    vfc_close(v);
+    return -1;
+  }
+  return 0;
+}
+
+void vfc_close(vfc_file_t *v) {
+  munmap((void *)v->base, v->size);
+  close(v->fd);
+}
+
+#define FAIL(...)                                                              \
+  do {                                                                         \
+    if (errors++ < max_errors) {                                               \
+      fprintf(stderr, "Error: " __VA_ARGS__);                                  \
+      fputc('\n', stderr);                                                     \
+    }                                                                          \
+  } while (0)
+
+int vfc_validate(const vfc_file_t *v, int max_errors) {
+  const vfc_header_t *h = &v->hdr;
+  int errors = 0;
+
+  if (h->version != VFC_VERSION)
+    FAIL("version %u, expected %u", h->version, VFC_VERSION);
+  if (h->header_bytes != sizeof(vfc_header_t))
+    FAIL("header is %u bytes, expected %zu", h->header_bytes,
+         sizeof(vfc_header_t));
+  uint64_t planes = 2; // In half frames: 3 for 4:2:0
+  if (h->pixel_format > VFC_FMT_I420)
+    FAIL("unknown pixel format %u", h->pixel_format);
+  else if ((uint64_t)h->width * vfc_bpp[h->pixel_format] > h->stride)
+    FAIL("stride %u is shorter than a %u pixel line", h->stride, h->width);
+  if (h->pixel_format == VFC_FMT_I420) {
+    planes = 3;
+    if ((h->width | h->height | h->stride) & 1)
+      FAIL("4:2:0 frame %ux%u (stride %u) is not even", h->width, h->height,
+           h->stride);
+  }
+  if ((uint64_t)h->stride * h->height * planes / 2 != h->frame_bytes)
+    FAIL("frame_bytes %u != stride x height%s", h->frame_bytes,
+         planes == 3 ? " x 1.5" : "");
+  if (h->fps_num == 0 || h->fps_den == 0)
+    FAIL("frame rate %u/%u", h->fps_num, h->fps_den);
+  if (h->frame_count == 0)
+    FAIL("no frames");
+  if (h->stripe_lines > h->height)
+    FAIL("stripe of %u lines in a %u line frame", h->stripe_lines, h->height);
+  if (!v->index && v->base && h->pixel_format == VFC_FMT_I420) {
+    for (uint32_t n = 0; n < h->frame_count; n++)
+      if (memcmp(vfc_frame(v, n) - Y4M_FRAME_LEN, Y4M_FRAME, Y4M_FRAME_LEN))
+        FAIL("Y4M frame %u does not start with a plain FRAME", n);
+  }
+  if (!v->index)
+    return errors; // Raw and Y4M: frame_count already fits the file
+  if (errors)
+    return errors; // Don't walk an index we can't trust
+
+  uint64_t index_end = (uint64_t)h->index_offset +
+                       (uint64_t)h->frame_count * sizeof(vfc_index_t);
+  if (h->index_offset % VFC_ALIGN || index_end > v->size) {
+    FAIL("index at 0x%X for %u frames does not fit the file", h->index_offset,
+         h->frame_count);
+    return errors;
+  }
+
+  uint64_t prev_end = index_end;
+  for (uint32_t n = 0; n < h->frame_count; n++) {
+    const vfc_index_t *e = &v->index[n];
+    if (e->offset % VFC_ALIGN)
+      FAIL("frame %u at 0x%llX is not %d-byte aligned", n,
+           (unsigned long long)e->offset, VFC_ALIGN);
+    if (e->offset < prev_end)
+      FAIL("frame %u at 0x%llX overlaps the previous data", n,
+           (unsigned long long)e->offset);
+    if (e->offset + e->bytes > v->size) {
+      FAIL("frame %u ends past the end of the file", n);
+      break;
+    }
+    if (e->flags == VFC_FLAG_LZ4 && h->stripe_lines) {
+      // Streaming readers check each table as the payload arrives
+      uint64_t total =
+          v->base ? vfc_stripe_table_bytes(h, v->base + e->offset, e->bytes)
+                  : e->bytes;
+      if (total != e->bytes)
+        FAIL("frame %u stripe table covers %llu of %u bytes", n,
+             (unsigned long long)total, e->bytes);
+    } else if (e->flags != 0 || e->bytes != h->frame_bytes) {
+      FAIL("frame %u is %u bytes (flags 0x%X)", n, e->bytes, e->flags);
+    }
+    prev_end = e->offset + e->bytes;
+  }
+  return errors;
+}
+
+uint64_t vfc_stripe_table_bytes(const vfc_header_t *h, const uint8_t *payload,
+                                uint32_t bytes) {
+  const uint32_t *size = (const uint32_t *)payload;
+  uint32_t stripes = vfc_stripes(h);
+  uint64_t total = (uint64_t)stripes * 4;
+  if (total > bytes)
+    return 0; // Table alone is longer than the payload
+  for (uint32_t s = 0; s < stripes && total <= bytes; s++)
+    total += size[s];
+  return total;
+}
+
+int vfc_decode_stripe(const vfc_header_t *h, const uint8_t *payload, uint32_t s,
+                      uint8_t *dst) {
+  const uint32_t *size = (const uint32_t *)payload;
+  uint32_t stripes = vfc_stripes(h);
+
+  // Blocks follow the table; offsets are validated, so a prefix sum is safe
+  const uint8_t *src = payload + stripes * 4;
+  for (uint32_t i = 0; i < s; i++)
+    src += size[i];
+
+  uint32_t lines = h->height - s * h->stripe_lines;
+  if (lines > h->stripe_lines)
+    lines = h->stripe_lines;
+  size_t want = (size_t)lines * h->stride;
+  if (lz4_decode_block(src, size[s], dst, want) != (long)want)
+    return -1;
+  return lines;
+}
@@ -0,0 +1,53 @@
+// Read-only mapping of a VFC container, a Y4M (4:2:0) stream or a legacy
+// headerless .raw file
+
+#ifndef VFC_FILE_H_
+#define VFC_FILE_H_
+
+#include "vfc.h"
+#include <stddef.h>
+
+// Headerless files from older img2raw.py: 960x540 XRGB32 at 60 fps
+#define VFC_RAW_WIDTH 960
+#define VFC_RAW_HEIGHT 540
+#define VFC_RAW_FPS 60
+
+typedef struct {
+  int fd;
+  const uint8_t *base;
+  size_t size;
+  vfc_header_t hdr; // Synthesized for raw and Y4M files
+  const vfc_index_t *index; // NULL for raw and Y4M files
+  // Without an index, frame n is at data_offset + n * frame_step
+  size_t data_offset;
+  size_t frame_step;
+} vfc_file_t;
+
+// Maps the file and fills in the header; no validation
+int vfc_map(vfc_file_t *v, const char *path);
+// vfc_map() + vfc_validate(), printing the first problem
+int vfc_open(vfc_file_t *v, const char *path);
+void vfc_close(vfc_file_t *v);
+// Checks the header and every index entry (and, if the file is mapped, every
+// stripe table); prints up to max_errors problems and returns the number found
+int vfc_validate(const vfc_file_t *v, int max_errors);
+
+static inline uint32_t vfc_stripes(const vfc_header_t *h) {
+  return (h->height + h->stripe_lines - 1) / h->stripe_lines;
+}
+
+// Payload bytes accounted for by the stripe table of a compressed frame;
+// equals bytes when the table is consistent
+uint64_t vfc_stripe_table_bytes(const vfc_header_t *h, const uint8_t *payload,
+                                uint32_t bytes);
+// Decodes stripe s of a compressed frame payload into dst (stripe_lines *
+// stride bytes); returns the lines decoded or -1 if the stripe is corrupt
+int vfc_decode_stripe(const vfc_header_t *h, const uint8_t *payload, uint32_t s,
+                      uint8_t *dst);
+
+static inline const uint8_t *vfc_frame(const vfc_file_t *v, uint32_t n) {
+  return v->index ? v->base + v->index[n].offset
+                  : v->base + v->data_offset + (size_t)n * v->frame_step;
+}
+
+#endif /* VFC_FILE_H_ */
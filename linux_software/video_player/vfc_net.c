@@ -0,0 +1,334 @@
+#include "vfc_net.h"
+#include "vfc_file.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#define VFC_NET_RCVBUF (8 << 20) // ~4 raw qHD frames
+
+static long long elapsed_ns(const struct timespec *t0) {
+  struct timespec t1;
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  return (t1.tv_sec - t0->tv_sec) * 1000000000LL + (t1.tv_nsec - t0->tv_nsec);
+}
+
+// Sockets with a receive timeout are never restarted after a signal, even
+// with SA_RESTART, so Ctrl-C gets through a blocked receive
+static void set_timeout(int fd) {
+  struct timeval tv = {1, 0};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+}
+
+static int timed_out(void) { return errno == EAGAIN || errno == EWOULDBLOCK; }
+
+// Fills buf completely; -1 on hang-up (errno 0), error or signal
+static int recv_all(int fd, void *buf, size_t len) {
+  uint8_t *p = buf;
+  while (len) {
+    ssize_t got = recv(fd, p, len, MSG_WAITALL);
+    if (got > 0) {
+      p += got;
+      len -= got;
+    } else if (got == 0) {
+      errno = 0;
+      return -1;
+    } else if (!timed_out()) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+// Counts up per frame; 0 means the sender restarted
+static int seq_newer(uint32_t a, uint32_t b) {
+  return a == 0 ? b != 0 : (int32_t)(a - b) > 0;
+}
+
+static int frame_ok(const vfc_net_t *n, const uint8_t *p, uint32_t bytes,
+                    uint32_t flags) {
+  if (flags == 0)
+    return bytes == n->hdr.frame_bytes;
+  return flags == VFC_FLAG_LZ4 && n->hdr.stripe_lines &&
+         vfc_stripe_table_bytes(&n->hdr, p, bytes) == bytes;
+}
+
+// Chunk i of the UDP frame in progress
+static int chunk_seen(const vfc_net_t *n, uint32_t i) {
+  return n->have[i >> 3] & (1 << (i & 7));
+}
+
+static void mark_chunk(vfc_net_t *n, uint32_t i) {
+  n->have[i >> 3] |= 1 << (i & 7);
+  n->got++;
+}
+
+static const uint8_t *deliver(vfc_net_t *n, const uint8_t *p, uint32_t s,
+                              uint32_t f, uint32_t *seq, uint32_t *flags) {
+  if (n->have_last && s != 0)
+    n->dropped += s - n->last_seq - 1;
+  n->have_last = 1;
+  n->last_seq = s;
+  n->frames++;
+  *seq = s;
+  *flags = f;
+  return p;
+}
+
+int vfc_net_open(vfc_net_t *n, const char *spec) {
+  memset(n, 0, sizeof(*n));
+  n->listen_fd = n->fd = -1;
+  if (strncmp(spec, "udp:", 4) == 0)
+    n->udp = 1;
+  else if (strncmp(spec, "tcp:", 4) != 0) {
+    fprintf(stderr, "Error: expected tcp:PORT or udp:PORT, got %s\n", spec);
+    return -1;
+  }
+  int port = spec[4] ? atoi(spec + 4) : VFC_NET_PORT;
+
+  int fd = socket(AF_INET, n->udp ? SOCK_DGRAM : SOCK_STREAM, 0);
+  if (fd == -1) {
+    perror("Error: socket() failed");
+    return -1;
+  }
+  if (n->udp)
+    n->fd = fd;
+  else
+    n->listen_fd = fd;
+
+  // Set before listen() so accepted sockets inherit it and the TCP window
+  // scale is sized for it. FORCE ignores rmem_max but needs root, which the
+  // player has anyway.
+  int one = 1, size = VFC_NET_RCVBUF;
+  socklen_t len = sizeof(n->rcvbuf);
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  if (setsockopt(fd, SOL_SOCKET, SO_RCVBUFFORCE, &size, sizeof(size)) != 0)
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+  getsockopt(fd, SOL_SOCKET, SO_RCVBUF, &n->rcvbuf, &len);
+  set_timeout(fd);
+
+  struct sockaddr_in addr = {0};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+      (!n->udp && listen(fd, 1) != 0)) {
+    perror("Error: could not listen");
+    goto fail;
+  }
+  printf("Waiting for a sender on %s port %d\n", n->udp ? "UDP" : "TCP", port);
+  fflush(stdout);
+
+  if (n->udp) {
+    n->bounce = malloc(VFC_NET_MAX_DATAGRAM);
+    if (!n->bounce)
+      goto fail;
+    for (;;) {
+      ssize_t got = recv(fd, n->bounce, VFC_NET_MAX_DATAGRAM, 0);
+      if (got == sizeof(vfc_header_t) &&
+          ((const vfc_header_t *)n->bounce)->magic == VFC_MAGIC) {
+        memcpy(&n->hdr, n->bounce, sizeof(n->hdr));
+        break;
+      }
+      if (got < 0 && !timed_out()) {
+        perror("Error: recv() failed");
+        goto fail;
+      }
+    }
+  } else {
+    struct sockaddr_in peer;
+    socklen_t peer_len = sizeof(peer);
+    while ((n->fd = accept(fd, (struct sockaddr *)&peer, &peer_len)) == -1) {
+      if (!timed_out()) {
+        perror("Error: accept() failed");
+        goto fail;
+      }
+    }
+    printf("Sender %s connected\n", inet_ntoa(peer.sin_addr));
+    set_timeout(n->fd);
+    if (recv_all(n->fd, &n->hdr, sizeof(n->hdr)) != 0 ||
+        n->hdr.magic != VFC_MAGIC) {
+      fprintf(stderr, "Error: no stream header from the sender\n");
+      goto fail;
+    }
+  }
+
+  // No index or mapping: only the header is checked
+  vfc_file_t check = {0};
+  check.hdr = n->hdr;
+  if (vfc_validate(&check, 1) != 0)
+    goto fail;
+  n->slot = malloc((size_t)n->hdr.frame_bytes + VFC_NET_MAX_DATAGRAM);
+  if (!n->slot)
+    goto fail;
+  // Chunks are at least a byte long
+  if (n->udp && !(n->have = malloc(n->hdr.frame_bytes / 8 + 1)))
+    goto fail;
+  clock_gettime(CLOCK_MONOTONIC, &n->start);
+  return 0;
+
+fail:
+  vfc_net_close(n);
+  return -1;
+}
+
+static const uint8_t *tcp_next(vfc_net_t *n, uint32_t *seq, uint32_t *flags,
+                               uint8_t *direct) {
+  for (;;) {
+    vfc_net_chunk_t c;
+    if (recv_all(n->fd, &c, sizeof(c)) != 0)
+      return NULL;
+    // A bad header means the byte stream is out of step; no way back in
+    if (c.magic != VFC_NET_MAGIC || c.bytes > n->hdr.frame_bytes ||
+        c.offset != 0 || c.length != c.bytes) {
+      fprintf(stderr, "Error: bad frame header from the sender\n");
+      return NULL;
+    }
+    uint8_t *dst = (c.flags == 0 && direct) ? direct : n->slot;
+    if (recv_all(n->fd, dst, c.bytes) != 0)
+      return NULL;
+    n->rx_bytes += sizeof(c) + c.bytes;
+    if (!frame_ok(n, dst, c.bytes, c.flags)) {
+      n->bad++;
+      continue;
+    }
+    return deliver(n, dst, c.seq, c.flags, seq, flags);
+  }
+}
+
+static const uint8_t *udp_next(vfc_net_t *n, uint32_t *seq, uint32_t *flags,
+                               uint8_t *direct) {
+  n->started = 0;
+  for (;;) {
+    // Land behind the data seen so far: in order, that is where it belongs.
+    // The caller's buffer is exactly one frame, so its tail uses the bounce.
+    uint8_t *base = n->started ? n->target : direct ? direct : n->slot;
+    size_t cap = n->hdr.frame_bytes;
+    if (base == n->slot)
+      cap += VFC_NET_MAX_DATAGRAM;
+    uint32_t end = n->started ? n->max_end : 0;
+    uint8_t *land =
+        cap - end >= VFC_NET_MAX_DATAGRAM ? base + end : n->bounce;
+
+    vfc_net_chunk_t c;
+    struct iovec iov[2] = {{&c, sizeof(c)}, {land, VFC_NET_MAX_DATAGRAM}};
+    struct msghdr msg = {0};
+    msg.msg_iov = iov;
+    msg.msg_iovlen = 2;
+    ssize_t got = recvmsg(n->fd, &msg, 0);
+    if (got < 0) {
+      if (timed_out())
+        continue;
+      return NULL;
+    }
+    n->rx_bytes += got;
+    if (got >= 4 && c.magic == VFC_MAGIC)
+      continue; // Repeated stream header
+    if (got < (ssize_t)sizeof(c) || c.magic != VFC_NET_MAGIC ||
+        c.length != got - sizeof(c) || c.bytes > n->hdr.frame_bytes ||
+        c.offset > c.bytes || c.length == 0 || c.length > c.bytes - c.offset) {
+      n->bad++;
+      continue;
+    }
+
+    if (n->started && c.seq != n->seq) {
+      if (!seq_newer(c.seq, n->seq))
+        continue; // Straggler from an abandoned frame
+      n->started = 0; // Incomplete; shows up as a sequence gap
+    }
+    if (!n->started) {
+      if (n->have_last && !seq_newer(c.seq, n->last_seq))
+        continue;
+      n->started = 1;
+      n->seq = c.seq;
+      n->bytes = c.bytes;
+      n->flags = c.flags;
+      n->chunk = n->got = n->early_tail = 0;
+      n->max_end = 0;
+      n->target = (c.flags == 0 && direct) ? direct : n->slot;
+    }
+    if (c.bytes != n->bytes || c.flags != n->flags) {
+      n->bad++;
+      continue;
+    }
+
+    // The sender cuts a frame into equal chunks and a shorter tail. The first
+    // datagram that is not the tail, or starts the frame, gives the size; a
+    // tail that came before it is checked against it then.
+    int tail = c.offset + c.length == n->bytes;
+    if (!n->chunk && (!tail || c.offset == 0)) {
+      n->chunk = c.length;
+      n->chunks = (n->bytes + c.length - 1) / c.length;
+      memset(n->have, 0, (n->chunks + 7) / 8);
+      if (n->early_tail) {
+        if (n->early_tail % n->chunk == 0 &&
+            n->bytes - n->early_tail <= n->chunk)
+          mark_chunk(n, n->early_tail / n->chunk);
+        else
+          n->bad++;
+        n->early_tail = 0;
+      }
+    }
+    if (n->chunk && (c.offset % n->chunk ||
+                     (tail ? c.length > n->chunk : c.length != n->chunk))) {
+      n->bad++;
+      continue;
+    }
+    if (n->chunk && chunk_seen(n, c.offset / n->chunk))
+      continue; // Duplicate
+
+    uint8_t *dst = n->target + c.offset;
+    if (dst != land)
+      memmove(dst, land, c.length);
+    if (c.offset + c.length > n->max_end)
+      n->max_end = c.offset + c.length;
+    if (!n->chunk) {
+      n->early_tail = c.offset;
+      continue;
+    }
+    mark_chunk(n, c.offset / n->chunk);
+    if (n->got < n->chunks)
+      continue;
+
+    n->started = 0;
+    if (!frame_ok(n, n->target, n->bytes, n->flags)) {
+      n->bad++;
+      continue;
+    }
+    return deliver(n, n->target, n->seq, n->flags, seq, flags);
+  }
+}
+
+const uint8_t *vfc_net_next(vfc_net_t *n, uint32_t *seq, uint32_t *flags,
+                            uint8_t *direct) {
+  return n->udp ? udp_next(n, seq, flags, direct)
+                : tcp_next(n, seq, flags, direct);
+}
+
+void vfc_net_print_stats(const vfc_net_t *n) {
+  double sec = elapsed_ns(&n->start) / 1e9;
+  printf("Received %.1f MB in %.1f s (%.1f MB/s), %llu frames (%.1f fps)\n",
+         n->rx_bytes / 1e6, sec, sec > 0 ? n->rx_bytes / 1e6 / sec : 0.0,
+         (unsigned long long)n->frames, sec > 0 ? n->frames / sec : 0.0);
+  printf("%llu frames dropped, %llu bad, %d KB socket buffer\n",
+         (unsigned long long)n->dropped, (unsigned long long)n->bad,
+         n->rcvbuf / 1024);
+}
+
+void vfc_net_close(vfc_net_t *n) {
+  if (n->fd != -1)
+    close(n->fd);
+  if (n->listen_fd != -1)
+    close(n->listen_fd);
+  free(n->slot);
+  free(n->bounce);
+  free(n->have);
+  n->fd = n->listen_fd = -1;
+  n->slot = n->bounce = n->have = NULL;
+}
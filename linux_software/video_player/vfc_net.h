@@ -0,0 +1,73 @@
+// Network frame receiver (TCP or UDP)
+//
+// The sender (linux_software/image_converter/vfc_send.py) first sends the
+// 64-byte vfc_header_t describing the stream, then frames. Every frame, or
+// with UDP every datagram of a frame, starts with a vfc_net_chunk_t. UDP
+// repeats the stream header about once a second so a late receiver can join.
+//
+// Plain frames are received straight into the caller's buffer (the back
+// buffer); compressed and YUV frames land in one staging slot. With UDP the
+// next datagram is received right behind the frame data seen so far, so
+// in-order datagrams need no copy; the rest are moved into place. A bit per
+// chunk records what has arrived, so a duplicated datagram cannot complete a
+// frame that still has holes.
+
+#ifndef VFC_NET_H_
+#define VFC_NET_H_
+
+#include "vfc.h"
+#include <stddef.h>
+#include <time.h>
+
+#define VFC_NET_PORT 5000
+#define VFC_NET_MAGIC 0x4E434656 // "VFCN"
+#define VFC_NET_MAX_DATAGRAM 65536
+
+typedef struct {
+  uint32_t magic; // VFC_NET_MAGIC
+  uint32_t seq;   // Frame number from the sender, 0 on (re)start
+  uint32_t bytes; // Payload bytes of the whole frame
+  uint32_t flags; // VFC_FLAG_*
+  uint32_t offset; // Where this chunk goes in the frame (TCP: 0)
+  uint32_t length; // Chunk bytes following this header (TCP: bytes)
+} vfc_net_chunk_t;
+
+_Static_assert(sizeof(vfc_net_chunk_t) == 24, "vfc_net_chunk_t layout");
+
+typedef struct {
+  int udp;
+  int listen_fd; // TCP only
+  int fd;
+  int rcvbuf; // Socket buffer the kernel granted
+  vfc_header_t hdr;
+  uint8_t *slot;    // frame_bytes + VFC_NET_MAX_DATAGRAM
+  uint8_t *bounce;  // UDP: when the caller's buffer has no room to land in
+
+  // UDP frame in progress
+  int started;
+  uint32_t seq, bytes, flags, max_end;
+  uint32_t chunk, chunks, got; // Chunk size (0 until known), count, received
+  uint32_t early_tail;         // Offset of a tail seen before the chunk size
+  uint8_t *have;               // Bit per chunk, frame_bytes / 8 + 1 bytes
+  uint8_t *target;
+  int have_last;
+  uint32_t last_seq; // Last complete frame
+
+  uint64_t rx_bytes;
+  uint64_t frames;
+  uint64_t dropped; // Sequence numbers skipped between complete frames
+  uint64_t bad;     // Malformed chunks or stripe tables
+  struct timespec start;
+} vfc_net_t;
+
+// spec is "tcp:PORT" or "udp:PORT"; waits for a sender and its stream header
+int vfc_net_open(vfc_net_t *n, const char *spec);
+// Returns the next complete frame and sets *seq and *flags, or NULL when the
+// sender hangs up or a signal arrives. Plain frames go to direct (frame_bytes
+// long) if it is not NULL; the result is valid until the next call.
+const uint8_t *vfc_net_next(vfc_net_t *n, uint32_t *seq, uint32_t *flags,
+                            uint8_t *direct);
+void vfc_net_print_stats(const vfc_net_t *n);
+void vfc_net_close(vfc_net_t *n);
+
+#endif /* VFC_NET_H_ */
@@ -0,0 +1,236 @@
+#define _GNU_SOURCE // O_DIRECT
+#include "vfc_stream.h"
+#include "vfc_file.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// No libaio on the board; the raw syscalls are all we need
+static int io_setup(unsigned nr, aio_context_t *ctx) {
+  return syscall(__NR_io_setup, nr, ctx);
+}
+static int io_destroy(aio_context_t ctx) {
+  return syscall(__NR_io_destroy, ctx);
+}
+static int io_submit(aio_context_t ctx, long nr, struct iocb **cbs) {
+  return syscall(__NR_io_submit, ctx, nr, cbs);
+}
+static int io_getevents(aio_context_t ctx, long min_nr, long nr,
+                        struct io_event *events) {
+  return syscall(__NR_io_getevents, ctx, min_nr, nr, events, NULL);
+}
+
+// O_DIRECT needs offset, length and buffer aligned to the logical block
+// size; VFC_ALIGN covers every card. Raw and Y4M frames are not page
+// aligned, so a read may start before and end after the payload.
+static uint64_t align_down(uint64_t x) { return x & ~(uint64_t)(VFC_ALIGN - 1); }
+static uint64_t align_up(uint64_t x) { return align_down(x + VFC_ALIGN - 1); }
+
+static long long elapsed_ns(const struct timespec *t0) {
+  struct timespec t1;
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  return (t1.tv_sec - t0->tv_sec) * 1000000000LL + (t1.tv_nsec - t0->tv_nsec);
+}
+
+static int submit(vfc_stream_t *s, uint32_t slot) {
+  const vfc_index_t *e = &s->index[s->next];
+  uint64_t start = align_down(e->offset);
+  struct iocb *cb = &s->iocb[slot];
+
+  memset(cb, 0, sizeof(*cb));
+  cb->aio_lio_opcode = IOCB_CMD_PREAD;
+  cb->aio_fildes = s->fd;
+  cb->aio_buf = (uintptr_t)(s->slots + slot * s->slot_bytes);
+  cb->aio_nbytes = align_up(e->offset + e->bytes) - start;
+  cb->aio_offset = start;
+  cb->aio_data = slot;
+  if (io_submit(s->ctx, 1, &cb) != 1) {
+    perror("Error: io_submit() failed");
+    return -1;
+  }
+  s->frame[slot] = s->next;
+  s->result[slot] = -EINPROGRESS;
+  s->in_flight++;
+  if (++s->next == s->hdr.frame_count)
+    s->next = 0;
+  return 0;
+}
+
+int vfc_stream_open(vfc_stream_t *s, const char *path, uint32_t depth,
+                    uint32_t start, uint8_t *slots, size_t slots_bytes) {
+  vfc_file_t v;
+
+  memset(s, 0, sizeof(*s));
+  s->fd = -1;
+  if (depth == 0 || depth > VFC_STREAM_MAX_DEPTH) {
+    fprintf(stderr, "Error: queue depth must be 1..%d\n", VFC_STREAM_MAX_DEPTH);
+    return -1;
+  }
+
+  // Header and index come through the page cache once, payloads never do
+  if (vfc_map(&v, path) != 0)
+    return -1;
+  // Unmapped: the header and index are checked (including that the index
+  // fits the file) before anything is copied; stripe tables are checked as
+  // frames arrive
+  vfc_file_t check = v;
+  check.base = NULL;
+  if (vfc_validate(&check, 1) != 0) {
+    vfc_close(&v);
+    return -1;
+  }
+  s->hdr = v.hdr;
+  s->index = malloc((size_t)s->hdr.frame_count * sizeof(vfc_index_t));
+  if (!s->index) {
+    vfc_close(&v);
+    return -1;
+  }
+  if (v.index) {
+    memcpy(s->index, v.index, (size_t)s->hdr.frame_count * sizeof(vfc_index_t));
+  } else {
+    for (uint32_t n = 0; n < s->hdr.frame_count; n++) {
+      s->index[n].offset = v.data_offset + (uint64_t)n * v.frame_step;
+      s->index[n].bytes = s->hdr.frame_bytes;
+      s->index[n].flags = 0;
+    }
+  }
+  vfc_close(&v);
+
+  s->fd = open(path, O_RDONLY | O_DIRECT);
+  s->direct = s->fd != -1;
+  if (s->fd == -1 && errno == EINVAL) // e.g. tmpfs
+    s->fd = open(path, O_RDONLY);
+  if (s->fd == -1) {
+    perror("Error: could not open video file");
+    goto fail;
+  }
+
+  for (uint32_t n = 0; n < s->hdr.frame_count; n++) {
+    const vfc_index_t *e = &s->index[n];
+    size_t len = align_up(e->offset + e->bytes) - align_down(e->offset);
+    if (len > s->slot_bytes)
+      s->slot_bytes = len;
+  }
+  if (slots && slots_bytes >= s->slot_bytes) {
+    s->external = 1;
+    s->slots = slots;
+    if (depth > slots_bytes / s->slot_bytes)
+      depth = slots_bytes / s->slot_bytes;
+    // Direct I/O needs pages it can pin; a driver mapping may not have them
+    if (s->direct && pread(s->fd, slots, VFC_ALIGN, 0) == -1 &&
+        errno == EFAULT) {
+      close(s->fd);
+      s->direct = 0;
+      s->fd = open(path, O_RDONLY);
+      if (s->fd == -1) {
+        perror("Error: could not open video file");
+        goto fail;
+      }
+    }
+  }
+  s->depth = depth;
+  if (!s->external &&
+      posix_memalign((void **)&s->slots, VFC_ALIGN, depth * s->slot_bytes)) {
+    fprintf(stderr, "Error: no memory for %u x %zu byte read slots\n", depth,
+            s->slot_bytes);
+    s->slots = NULL;
+    goto fail;
+  }
+  if (io_setup(depth, &s->ctx) != 0) {
+    perror("Error: io_setup() failed");
+    goto fail;
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &s->start);
+  s->next = start % s->hdr.frame_count;
+  for (uint32_t slot = 0; slot < depth; slot++)
+    if (submit(s, slot) != 0)
+      goto fail;
+  return 0;
+
+fail:
+  vfc_stream_close(s);
+  return -1;
+}
+
+const uint8_t *vfc_stream_next(vfc_stream_t *s, uint32_t *n) {
+  if (s->held && submit(s, (s->head + s->depth - 1) % s->depth) != 0)
+    return NULL;
+  s->held = 0;
+
+  uint32_t slot = s->head;
+  s->depth_sum += s->in_flight;
+  if (s->result[slot] == -EINPROGRESS) {
+    struct timespec t0;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    s->stalls++;
+    while (s->result[slot] == -EINPROGRESS) {
+      struct io_event ev[VFC_STREAM_MAX_DEPTH];
+      int got = io_getevents(s->ctx, 1, s->depth, ev);
+      if (got < 0 && errno == EINTR)
+        continue;
+      if (got < 0) {
+        perror("Error: io_getevents() failed");
+        return NULL;
+      }
+      for (int i = 0; i < got; i++) {
+        s->result[ev[i].data] = ev[i].res;
+        s->in_flight--;
+        if (ev[i].res > 0)
+          s->bytes += ev[i].res;
+      }
+    }
+    s->wait_ns += elapsed_ns(&t0);
+  }
+
+  const vfc_index_t *e = &s->index[s->frame[slot]];
+  uint32_t skip = e->offset - align_down(e->offset);
+  if (s->result[slot] < (long)(skip + e->bytes)) {
+    fprintf(stderr, "Error: frame %u read returned %ld\n", s->frame[slot],
+            s->result[slot]);
+    return NULL;
+  }
+  const uint8_t *payload = s->slots + slot * s->slot_bytes + skip;
+  if ((e->flags & VFC_FLAG_LZ4) &&
+      vfc_stripe_table_bytes(&s->hdr, payload, e->bytes) != e->bytes) {
+    fprintf(stderr, "Error: frame %u has a corrupt stripe table\n",
+            s->frame[slot]);
+    return NULL;
+  }
+
+  *n = s->frame[slot];
+  s->head = (slot + 1) % s->depth;
+  s->held = 1;
+  s->frames++;
+  return payload;
+}
+
+void vfc_stream_print_stats(const vfc_stream_t *s) {
+  double sec = elapsed_ns(&s->start) / 1e9;
+  printf("Read %.1f MB in %.1f s (%.1f MB/s%s), %llu frames\n", s->bytes / 1e6,
+         sec, sec > 0 ? s->bytes / 1e6 / sec : 0.0,
+         s->direct ? "" : ", page cache", (unsigned long long)s->frames);
+  if (s->frames)
+    printf("Queue depth %.1f of %u on average, %llu stalls (%lld ms waiting)\n",
+           (double)s->depth_sum / s->frames, s->depth,
+           (unsigned long long)s->stalls, s->wait_ns / 1000000);
+}
+
+void vfc_stream_close(vfc_stream_t *s) {
+  if (s->ctx)
+    io_destroy(s->ctx); // Waits for reads still in flight
+  if (!s->external)
+    free(s->slots);
+  free(s->index);
+  if (s->fd != -1)
+    close(s->fd);
+  s->ctx = 0;
+  s->slots = NULL;
+  s->index = NULL;
+  s->fd = -1;
+}
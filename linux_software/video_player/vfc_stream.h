@@ -0,0 +1,58 @@
+// Asynchronous O_DIRECT frame reader
+//
+// Keeps `depth` frame reads in flight with Linux AIO, so the SD card never
+// idles while the player copies or decodes a frame. Reads bypass the page
+// cache and land in page-aligned staging slots allocated once at open, or in
+// a buffer the caller passes in (the player's DMA staging area, so that the
+// slot -> frame buffer copy is not done by the CPU either).
+
+#ifndef VFC_STREAM_H_
+#define VFC_STREAM_H_
+
+#include "vfc.h"
+#include <linux/aio_abi.h>
+#include <stddef.h>
+#include <time.h>
+
+#define VFC_STREAM_MAX_DEPTH 16
+
+typedef struct {
+  int fd;
+  int direct; // 0 if the filesystem refused O_DIRECT (page cache reads)
+  vfc_header_t hdr;
+  vfc_index_t *index; // Copy of the file's index, synthesized for raw files
+  aio_context_t ctx;
+  uint32_t depth;
+  size_t slot_bytes;
+  uint8_t *slots; // depth * slot_bytes
+  int external;   // slots belong to the caller
+  struct iocb iocb[VFC_STREAM_MAX_DEPTH];
+  long result[VFC_STREAM_MAX_DEPTH]; // Bytes read or -errno once complete
+  uint32_t frame[VFC_STREAM_MAX_DEPTH];
+  uint32_t head;    // Slot handed out next
+  int held;         // Slot before head is with the caller
+  uint32_t next;    // Frame number of the next read
+  uint32_t in_flight;
+
+  uint64_t bytes;
+  uint64_t frames;
+  uint64_t depth_sum; // in_flight sampled at each vfc_stream_next()
+  uint64_t stalls;    // Oldest read was still pending
+  long long wait_ns;
+  struct timespec start;
+} vfc_stream_t;
+
+// Validates the header and index and queues the first depth reads from frame
+// start (modulo frame_count). If slots is not NULL (VFC_ALIGN aligned) reads
+// land there, and depth is lowered to the slots that fit in slots_bytes; if
+// not even one fits, slots are allocated as usual and external stays 0.
+int vfc_stream_open(vfc_stream_t *s, const char *path, uint32_t depth,
+                    uint32_t start, uint8_t *slots, size_t slots_bytes);
+// Requeues the previous slot, then waits for the oldest read. Frames come in
+// order and loop; returns the payload (valid until the next call) and sets *n,
+// or returns NULL on a read error or a corrupt stripe table.
+const uint8_t *vfc_stream_next(vfc_stream_t *s, uint32_t *n);
+void vfc_stream_print_stats(const vfc_stream_t *s);
+void vfc_stream_close(vfc_stream_t *s);
+
+#endif /* VFC_STREAM_H_ */
@@ -0,0 +1,455 @@
+// Triple-buffered video player for the HDMI pipeline
+//
+// Plays a VFC container (see vfc.h), a Y4M 4:2:0 stream or a headerless
+// 960x540 .raw file in a loop. Frame n is found through the index, so
+// starting anywhere or looping costs nothing. Each frame is copied into the
+// back buffer, then the HDMI frame pointer is set. The pointer is latched on
+// V-Sync, so until then the previous frame is still being scanned out; the
+// third slot gives that frame a refresh to finish before it is overwritten.
+//
+// Plain XRGB frames are read into a u-dma-buf staging area (-d) and copied
+// into the back buffer by burst_master_4 (see bm4_dma.h), so the A9 never
+// writes them through the uncached frame buffer mapping; -d off, or a
+// missing staging buffer or UIO device, falls back to memcpy().
+//
+// By default frames are streamed with -q reads in flight (see vfc_stream.h);
+// -q 0 mmaps the file instead, which suits files already in RAM. tcp:PORT or
+// udp:PORT receives a live stream from vfc_send.py (see vfc_net.h) and shows
+// each frame as it arrives; the sender sets the pace.
+//
+// LZ4-striped frames are decoded by DECODE_THREADS threads (one per Cortex-A9
+// core), stripes dealt round-robin, then copied into the back buffer. YUV
+// frames are split the same way by rows and converted with NEON straight
+// into the back buffer (-c picks the BT.601 or BT.709 matrix).
+//
+// Usage: video_player [-q depth] [-c 601|709] [-d udmabufN|off] [-u /dev/uioN]
+//                     <file.vfc | file.y4m | file.raw | tcp:PORT | udp:PORT>
+//                     [start_frame]
+
+#include "bm4_dma.h"
+#include "vfc_file.h"
+#include "vfc_net.h"
+#include "vfc_stream.h"
+#include "yuv2rgb.h"
+
+#include <fcntl.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#define FRAME_BUFFER_BASE 0x30000000
+#define FRAME_SLOT_BYTES 0x200000 // Slots at 0x30000000, 0x30200000, ...
+#define FRAME_SLOTS 3
+#define FRAME_WIDTH 960
+#define FRAME_HEIGHT 540
+
+#define HDMI_CSR_BASE 0xFF240000 // hdmi_sync_gen on the lightweight bridge
+#define REG_FRAME_PTR 6
+// hdmi_sync_gen: 1120 x 563 at 37.8 MHz, 59.94 Hz. No V-Sync status in the
+// CSR, so one refresh after a pointer write is when it is surely latched.
+#define REFRESH_NS (1000000000LL * 1120 * 563 / 37800000)
+
+#define DECODE_THREADS 2
+#define DEFAULT_QUEUE_DEPTH 4
+#define DMA_TIMEOUT_MS 1000
+
+static volatile sig_atomic_t running = 1;
+
+static void on_signal(int sig) {
+  (void)sig;
+  running = 0;
+}
+
+static enum { SRC_FILE, SRC_STREAM, SRC_NET } source;
+static vfc_file_t file;
+static vfc_stream_t stream;
+static vfc_net_t net;
+
+// Staging area: BM4_CTL_BYTES of descriptors and ring, then the read slots
+static int dma;
+static bm4_buf_t staging;
+static bm4_dev_t bm4;
+
+static int dma_open(const char *name, const char *uio) {
+  if (bm4_buf_open(&staging, name) != 0)
+    return -1;
+  if (bm4_open(&bm4, uio, &staging, 0) != 0) {
+    bm4_buf_close(&staging);
+    return -1;
+  }
+  return 0;
+}
+
+static void dma_close(void) {
+  if (!dma)
+    return;
+  bm4_close(&bm4);
+  bm4_buf_close(&staging);
+  dma = 0;
+}
+
+// The stream reads into the staging area, so it goes first
+static void close_input(void) {
+  if (source == SRC_NET)
+    vfc_net_close(&net);
+  else if (source == SRC_STREAM)
+    vfc_stream_close(&stream);
+  else
+    vfc_close(&file);
+  dma_close();
+}
+
+typedef struct {
+  const vfc_header_t *h; // NULL tells the thread to exit
+  const uint8_t *payload;
+  uint8_t *dst;
+  uint32_t id;
+  uint8_t *scratch; // One stripe
+  unsigned long errors;
+} decoder_t;
+
+static decoder_t decoders[DECODE_THREADS];
+static pthread_barrier_t start_barrier, done_barrier;
+static const yuv_matrix_t *matrix = &yuv_bt601;
+
+// The frame buffer mapping is uncached and LZ4 matches read back what was
+// just written, so each stripe is decoded into cached scratch and copied out
+static void decode_share(decoder_t *d) {
+  const vfc_header_t *h = d->h;
+
+  if (h->pixel_format == VFC_FMT_I420) {
+    // Contiguous halves keep each core's writes sequential
+    uint32_t pairs = (h->height / 2 + DECODE_THREADS - 1) / DECODE_THREADS;
+    uint32_t row0 = d->id * pairs * 2;
+    if (row0 < h->height)
+      i420_to_xrgb(d->payload, h->width, h->height, row0,
+                   row0 + pairs * 2 > h->height ? h->height - row0 : pairs * 2,
+                   d->dst, FRAME_WIDTH * 4, matrix);
+    return;
+  }
+
+  uint32_t stripes = vfc_stripes(h);
+
+  for (uint32_t s = d->id; s < stripes; s += DECODE_THREADS) {
+    int lines = vfc_decode_stripe(h, d->payload, s, d->scratch);
+    if (lines < 0) {
+      d->errors++;
+      continue;
+    }
+    uint8_t *out = d->dst + (size_t)s * h->stripe_lines * FRAME_WIDTH * 4;
+    for (int y = 0; y < lines; y++)
+      memcpy(out + y * FRAME_WIDTH * 4, d->scratch + y * h->stride,
+             FRAME_WIDTH * 4);
+  }
+}
+
+static void *decoder_thread(void *arg) {
+  decoder_t *d = arg;
+  for (;;) {
+    pthread_barrier_wait(&start_barrier);
+    if (!d->h)
+      break;
+    decode_share(d);
+    pthread_barrier_wait(&done_barrier);
+  }
+  return NULL;
+}
+
+int main(int argc, char **argv) {
+  uint32_t depth = DEFAULT_QUEUE_DEPTH;
+  const char *dma_buf = "udmabuf0", *uio = "/dev/uio0";
+  int opt;
+  while ((opt = getopt(argc, argv, "q:c:d:u:")) != -1) {
+    if (opt == 'q')
+      depth = strtoul(optarg, NULL, 0);
+    else if (opt == 'd')
+      dma_buf = optarg;
+    else if (opt == 'u')
+      uio = optarg;
+    else if (opt == 'c' && strcmp(optarg, "601") == 0)
+      matrix = &yuv_bt601;
+    else if (opt == 'c' && strcmp(optarg, "709") == 0)
+      matrix = &yuv_bt709;
+    else
+      break;
+  }
+  if (opt != -1 || optind >= argc) {
+    printf("Usage: %s [-q depth] [-c 601|709] [-d udmabufN|off] "
+           "[-u /dev/uioN]\n"
+           "       <file.vfc | file.y4m | file.raw | tcp:PORT | udp:PORT> "
+           "[start_frame]\n"
+           "  -q  reads in flight, 1..%d (default %d); 0 maps the file\n"
+           "  -c  YUV matrix for 4:2:0 input (default 601)\n"
+           "  -d  DMA staging buffer for plain frames (default udmabuf0)\n"
+           "  -u  burst_master_4 UIO device (default /dev/uio0)\n",
+           argv[0], VFC_STREAM_MAX_DEPTH, DEFAULT_QUEUE_DEPTH);
+    return 1;
+  }
+  const char *path = argv[optind];
+  uint32_t start = (optind + 1 < argc) ? strtoul(argv[optind + 1], NULL, 0) : 0;
+
+  const vfc_header_t *h;
+  const vfc_index_t *index = NULL;
+  if (strncmp(path, "tcp:", 4) == 0 || strncmp(path, "udp:", 4) == 0)
+    source = SRC_NET;
+  else if (depth != 0)
+    source = SRC_STREAM;
+  if (source == SRC_NET) {
+    if (vfc_net_open(&net, path) != 0)
+      return 1;
+    h = &net.hdr;
+  } else if (source == SRC_STREAM) {
+    if (strcmp(dma_buf, "off") != 0) {
+      // LZ4 and YUV payloads are read by the CPU, which is slow from the
+      // uncached staging area; only plain frames go through the engine
+      vfc_file_t v;
+      if (vfc_map(&v, path) != 0)
+        return 1;
+      dma = v.hdr.stripe_lines == 0 && v.hdr.pixel_format == VFC_FMT_XRGB32 &&
+            v.hdr.stride == FRAME_WIDTH * 4;
+      vfc_close(&v);
+      if (dma && dma_open(dma_buf, uio) != 0) {
+        fprintf(stderr, "Warning: no DMA, copying frames with the CPU\n");
+        dma = 0;
+      }
+    }
+    if (vfc_stream_open(&stream, path, depth, start,
+                        dma ? (uint8_t *)staging.virt + BM4_CTL_BYTES : NULL,
+                        dma ? staging.size - BM4_CTL_BYTES : 0) != 0) {
+      dma_close();
+      return 1;
+    }
+    if (dma && !stream.external) {
+      fprintf(stderr, "Warning: %s is too small for a frame, copying frames "
+                      "with the CPU\n", dma_buf);
+      dma_close();
+    }
+    depth = stream.depth;
+    h = &stream.hdr;
+    index = stream.index;
+  } else {
+    if (vfc_open(&file, path) != 0)
+      return 1;
+    h = &file.hdr;
+    index = file.index;
+  }
+  int yuv = h->pixel_format == VFC_FMT_I420;
+  if (h->width != FRAME_WIDTH || h->height != FRAME_HEIGHT ||
+      (h->pixel_format != VFC_FMT_XRGB32 && !yuv)) {
+    fprintf(stderr,
+            "Error: %ux%u format %u, the display needs %dx%d XRGB32 or I420\n",
+            h->width, h->height, h->pixel_format, FRAME_WIDTH, FRAME_HEIGHT);
+    close_input();
+    return 1;
+  }
+  if (yuv && (h->stride != h->width || h->stripe_lines)) {
+    fprintf(stderr, "Error: I420 frames must be packed and uncompressed\n");
+    close_input();
+    return 1;
+  }
+  uint32_t frame = start % h->frame_count;
+
+  int fd = open("/dev/mem", O_RDWR | O_SYNC);
+  if (fd == -1) {
+    perror("Error: could not open \"/dev/mem\"");
+    close_input();
+    return 1;
+  }
+  uint8_t *fb = mmap(NULL, FRAME_SLOTS * FRAME_SLOT_BYTES,
+                     PROT_READ | PROT_WRITE, MAP_SHARED, fd, FRAME_BUFFER_BASE);
+  volatile uint32_t *hdmi =
+      mmap(NULL, sysconf(_SC_PAGESIZE), PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+           HDMI_CSR_BASE);
+  if (fb == MAP_FAILED || hdmi == MAP_FAILED) {
+    perror("Error: mmap() failed");
+    close(fd);
+    close_input();
+    return 1;
+  }
+
+  signal(SIGINT, on_signal);
+  signal(SIGTERM, on_signal);
+
+  // Decoder 0 is this thread
+  pthread_t threads[DECODE_THREADS];
+  int compressed = h->stripe_lines != 0;
+  if (compressed || yuv) {
+    pthread_barrier_init(&start_barrier, NULL, DECODE_THREADS);
+    pthread_barrier_init(&done_barrier, NULL, DECODE_THREADS);
+    for (uint32_t i = 0; i < DECODE_THREADS; i++) {
+      decoders[i].h = h;
+      decoders[i].id = i;
+      if (compressed)
+        decoders[i].scratch = malloc((size_t)h->stripe_lines * h->stride);
+      if (i > 0)
+        pthread_create(&threads[i], NULL, decoder_thread, &decoders[i]);
+    }
+  }
+
+  const char *kind = "";
+  if (compressed)
+    kind = " (LZ4 stripes)";
+  else if (yuv)
+    kind = matrix == &yuv_bt709 ? " (I420, BT.709)" : " (I420, BT.601)";
+  printf("Playing %s: %u frames, %ux%u @ %u/%u fps%s\n", path,
+         h->frame_count, h->width, h->height, h->fps_num, h->fps_den, kind);
+  if (source == SRC_STREAM)
+    printf("Streaming %u reads ahead%s%s\n", depth,
+           stream.direct ? " with O_DIRECT" : " through the page cache",
+           dma ? ", copied by burst_master_4" : "");
+
+  // Absolute deadlines keep the average rate exact even if a copy runs late
+  long period_ns = 1000000000LL * h->fps_den / h->fps_num;
+  struct timespec next;
+  clock_gettime(CLOCK_MONOTONIC, &next);
+  // Start after whichever slot is on screen (slot 0 after reset). prev_swap
+  // is when the slot now on screen, or about to be, was set; the back buffer
+  // was the front before it, so it is free once that pointer is latched.
+  uint32_t shown_at = hdmi[REG_FRAME_PTR] - FRAME_BUFFER_BASE;
+  int back = shown_at < FRAME_SLOTS * FRAME_SLOT_BYTES
+                 ? (shown_at / FRAME_SLOT_BYTES + 1) % FRAME_SLOTS
+                 : 0;
+  struct timespec prev_swap = {0, 0}, last_swap = {0, 0};
+  unsigned long shown = 0, late = 0, decoded = 0;
+  long long decode_ns = 0, dma_ns = 0;
+
+  while (running) {
+    struct timespec free_at = prev_swap;
+    free_at.tv_nsec += REFRESH_NS;
+    while (free_at.tv_nsec >= 1000000000L) {
+      free_at.tv_nsec -= 1000000000L;
+      free_at.tv_sec++;
+    }
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &free_at, NULL);
+
+    const uint8_t *src;
+    uint8_t *dst = fb + back * FRAME_SLOT_BYTES;
+    uint32_t flags = 0, ticket = 0;
+    int copying = 0;
+    if (source == SRC_NET) {
+      // Plain frames are received straight into the back buffer
+      src = vfc_net_next(&net, &frame, &flags,
+                         !yuv && h->stride == FRAME_WIDTH * 4 ? dst : NULL);
+      if (!src)
+        break;
+    } else if (source == SRC_STREAM) {
+      src = vfc_stream_next(&stream, &frame);
+      if (!src)
+        break;
+    } else {
+      src = vfc_frame(&file, frame);
+    }
+    if (index)
+      flags = index[frame].flags;
+
+    if (yuv || (flags & VFC_FLAG_LZ4)) {
+      struct timespec t0, t1;
+      clock_gettime(CLOCK_MONOTONIC, &t0);
+      for (int i = 0; i < DECODE_THREADS; i++) {
+        decoders[i].payload = src;
+        decoders[i].dst = dst;
+      }
+      pthread_barrier_wait(&start_barrier);
+      decode_share(&decoders[0]);
+      pthread_barrier_wait(&done_barrier);
+      clock_gettime(CLOCK_MONOTONIC, &t1);
+      decode_ns += (t1.tv_sec - t0.tv_sec) * 1000000000LL +
+                   (t1.tv_nsec - t0.tv_nsec);
+      decoded++;
+    } else if (src == dst) {
+      // Already in place
+    } else if (dma) {
+      // The engine copies while this thread sleeps until the deadline; the
+      // slot is not requeued before the next vfc_stream_next()
+      if (bm4_submit_copy(&bm4, FRAME_BUFFER_BASE + back * FRAME_SLOT_BYTES,
+                          staging.phys +
+                              (uint32_t)(src - (uint8_t *)staging.virt),
+                          h->frame_bytes, &ticket) != 0) {
+        perror("Error: bm4_submit_copy() failed");
+        break;
+      }
+      copying = 1;
+    } else if (h->stride == FRAME_WIDTH * 4) {
+      memcpy(dst, src, h->frame_bytes);
+    } else {
+      for (uint32_t y = 0; y < FRAME_HEIGHT; y++)
+        memcpy(dst + y * FRAME_WIDTH * 4, src + y * h->stride,
+               FRAME_WIDTH * 4);
+    }
+
+    // A network sender sets the pace, so its frames are shown on arrival
+    if (source != SRC_NET) {
+      next.tv_nsec += period_ns;
+      while (next.tv_nsec >= 1000000000L) {
+        next.tv_nsec -= 1000000000L;
+        next.tv_sec++;
+      }
+      struct timespec now;
+      clock_gettime(CLOCK_MONOTONIC, &now);
+      if (now.tv_sec > next.tv_sec ||
+          (now.tv_sec == next.tv_sec && now.tv_nsec > next.tv_nsec))
+        late++;
+      else
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+    }
+
+    if (copying) {
+      struct timespec t0, t1;
+      clock_gettime(CLOCK_MONOTONIC, &t0);
+      int done = bm4_wait(&bm4, ticket, DMA_TIMEOUT_MS);
+      clock_gettime(CLOCK_MONOTONIC, &t1);
+      dma_ns += (t1.tv_sec - t0.tv_sec) * 1000000000LL +
+                (t1.tv_nsec - t0.tv_nsec);
+      if (done != (int)h->frame_bytes) {
+        fprintf(stderr, "Error: DMA of frame %u returned %d\n", frame, done);
+        break;
+      }
+    }
+
+    hdmi[REG_FRAME_PTR] = FRAME_BUFFER_BASE + back * FRAME_SLOT_BYTES;
+    prev_swap = last_swap;
+    clock_gettime(CLOCK_MONOTONIC, &last_swap);
+    back = (back + 1) % FRAME_SLOTS;
+    shown++;
+    if (++frame == h->frame_count)
+      frame = 0;
+  }
+
+  printf("\nShown %lu frames, %lu late\n", shown, late);
+  if (source == SRC_STREAM)
+    vfc_stream_print_stats(&stream);
+  else if (source == SRC_NET)
+    vfc_net_print_stats(&net);
+  if (dma && shown)
+    printf("DMA copies: %lld us average wait after the deadline\n",
+           dma_ns / shown / 1000);
+  if (compressed || yuv) {
+    unsigned long errors = 0;
+    for (int i = 0; i < DECODE_THREADS; i++) {
+      errors += decoders[i].errors;
+      decoders[i].h = NULL;
+    }
+    pthread_barrier_wait(&start_barrier);
+    for (int i = 1; i < DECODE_THREADS; i++)
+      pthread_join(threads[i], NULL);
+    for (int i = 0; i < DECODE_THREADS; i++)
+      free(decoders[i].scratch);
+    if (decoded && yuv)
+      printf("Converted %lu frames, %lld us average\n", decoded,
+             decode_ns / decoded / 1000);
+    else if (decoded)
+      printf("Decoded %lu frames, %lld us average, %lu corrupt stripes\n",
+             decoded, decode_ns / decoded / 1000, errors);
+  }
+  munmap((void *)hdmi, sysconf(_SC_PAGESIZE));
+  munmap(fb, FRAME_SLOTS * FRAME_SLOT_BYTES);
+  close(fd);
+  close_input();
+  return 0;
+}
@@ -0,0 +1,97 @@
+#include "yuv2rgb.h"
+
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+// R = 1.164 (Y - 16) + rv (V - 128)
+// G = 1.164 (Y - 16) - gu (U - 128) - gv (V - 128)
+// B = 1.164 (Y - 16) + bu (U - 128)
+const yuv_matrix_t yuv_bt601 = {149, 1192, 102, 25, 52, 129};
+const yuv_matrix_t yuv_bt709 = {149, 1192, 115, 14, 34, 135};
+
+static inline uint8_t clamp_q6(int x) {
+  x = (x + 32) >> 6;
+  return x < 0 ? 0 : x > 255 ? 255 : x;
+}
+
+// Same arithmetic as the NEON path, so both give identical pixels
+static void convert_pixels(const uint8_t *y, int u, int v, uint8_t *out,
+                           int n, const yuv_matrix_t *m) {
+  u -= 128;
+  v -= 128;
+  for (int i = 0; i < n; i++) {
+    int l = ((y[i] * m->y_gain) >> 1) - m->y_offset;
+    out[4 * i + 0] = clamp_q6(l + m->bu * u);
+    out[4 * i + 1] = clamp_q6(l - m->gu * u - m->gv * v);
+    out[4 * i + 2] = clamp_q6(l + m->rv * v);
+    out[4 * i + 3] = 0;
+  }
+}
+
+#ifdef __ARM_NEON
+static inline int16x8_t luma_q6(uint8x8_t y, const yuv_matrix_t *m) {
+  uint16x8_t l = vshrq_n_u16(vmull_u8(y, vdup_n_u8(m->y_gain)), 1);
+  return vsubq_s16(vreinterpretq_s16_u16(l), vdupq_n_s16(m->y_offset));
+}
+
+static inline uint8x16_t pack_q6(int16x8_t lo, int16x8_t hi) {
+  return vcombine_u8(vqrshrun_n_s16(lo, 6), vqrshrun_n_s16(hi, 6));
+}
+
+// 16 pixels of two lines per pass: the 8 chroma terms are computed once,
+// doubled horizontally with a zip and shared by both lines
+static uint32_t convert_line_pair(const uint8_t *y0, const uint8_t *y1,
+                                  const uint8_t *u, const uint8_t *v,
+                                  uint8_t *out0, uint8_t *out1, uint32_t width,
+                                  const yuv_matrix_t *m) {
+  uint32_t x;
+  for (x = 0; x + 16 <= width; x += 16) {
+    int16x8_t cu =
+        vreinterpretq_s16_u16(vsubl_u8(vld1_u8(u + x / 2), vdup_n_u8(128)));
+    int16x8_t cv =
+        vreinterpretq_s16_u16(vsubl_u8(vld1_u8(v + x / 2), vdup_n_u8(128)));
+    int16x8_t b = vmulq_n_s16(cu, m->bu);
+    int16x8_t g = vaddq_s16(vmulq_n_s16(cu, m->gu), vmulq_n_s16(cv, m->gv));
+    int16x8_t r = vmulq_n_s16(cv, m->rv);
+    int16x8x2_t b2 = vzipq_s16(b, b), g2 = vzipq_s16(g, g), r2 = vzipq_s16(r, r);
+
+    for (int line = 0; line < 2; line++) {
+      uint8x16_t yy = vld1q_u8((line ? y1 : y0) + x);
+      int16x8_t lo = luma_q6(vget_low_u8(yy), m);
+      int16x8_t hi = luma_q6(vget_high_u8(yy), m);
+      uint8x16x4_t px;
+      // Saturation only kicks in far above 255, so it never changes a pixel
+      px.val[0] = pack_q6(vqaddq_s16(lo, b2.val[0]), vqaddq_s16(hi, b2.val[1]));
+      px.val[1] = pack_q6(vqsubq_s16(lo, g2.val[0]), vqsubq_s16(hi, g2.val[1]));
+      px.val[2] = pack_q6(vqaddq_s16(lo, r2.val[0]), vqaddq_s16(hi, r2.val[1]));
+      px.val[3] = vdupq_n_u8(0);
+      vst4q_u8((line ? out1 : out0) + x * 4, px);
+    }
+  }
+  return x;
+}
+#endif
+
+void i420_to_xrgb(const uint8_t *src, uint32_t width, uint32_t height,
+                  uint32_t row0, uint32_t rows, uint8_t *dst,
+                  uint32_t dst_stride, const yuv_matrix_t *m) {
+  const uint8_t *y_plane = src;
+  const uint8_t *u_plane = y_plane + width * height;
+  const uint8_t *v_plane = u_plane + (width / 2) * (height / 2);
+
+  for (uint32_t row = row0; row < row0 + rows; row += 2) {
+    const uint8_t *y0 = y_plane + row * width, *y1 = y0 + width;
+    const uint8_t *u = u_plane + (row / 2) * (width / 2);
+    const uint8_t *v = v_plane + (row / 2) * (width / 2);
+    uint8_t *out0 = dst + row * dst_stride, *out1 = out0 + dst_stride;
+    uint32_t x = 0;
+#ifdef __ARM_NEON
+    x = convert_line_pair(y0, y1, u, v, out0, out1, width, m);
+#endif
+    for (; x < width; x += 2) {
+      convert_pixels(y0 + x, u[x / 2], v[x / 2], out0 + x * 4, 2, m);
+      convert_pixels(y1 + x, u[x / 2], v[x / 2], out1 + x * 4, 2, m);
+    }
+  }
+}
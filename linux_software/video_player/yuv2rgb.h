@@ -0,0 +1,24 @@
+// I420 (planar YUV 4:2:0) to XRGB32 conversion, NEON on the Cortex-A9
+
+#ifndef YUV2RGB_H_
+#define YUV2RGB_H_
+
+#include <stdint.h>
+
+// Limited-range coefficients: luma gain in Q7, chroma terms in Q6
+typedef struct {
+  uint8_t y_gain;
+  int16_t y_offset; // 16 * gain, Q6
+  int16_t rv, gu, gv, bu;
+} yuv_matrix_t;
+
+extern const yuv_matrix_t yuv_bt601, yuv_bt709;
+
+// Converts rows [row0, row0 + rows) of a width x height I420 image (Y, U and
+// V planes back to back) into dst, which points at row 0. width, height, row0
+// and rows must be even.
+void i420_to_xrgb(const uint8_t *src, uint32_t width, uint32_t height,
+                  uint32_t row0, uint32_t rows, uint8_t *dst,
+                  uint32_t dst_stride, const yuv_matrix_t *m);
+
+#endif /* YUV2RGB_H_ */
@@ -245,8 +245,8 @@
 
 #define ALT_MODULE_CLASS_burst_master_0 burst_master
 #define BURST_MASTER_0_BASE 0x200a0
-#define BURST_MASTER_0_IRQ -1
-#define BURST_MASTER_0_IRQ_INTERRUPT_CONTROLLER_ID -1
+#define BURST_MASTER_0_IRQ 3
+#define BURST_MASTER_0_IRQ_INTERRUPT_CONTROLLER_ID 0
 #define BURST_MASTER_0_NAME "/dev/burst_master_0"
 #define BURST_MASTER_0_SPAN 32
 #define BURST_MASTER_0_TYPE "burst_master"
@@ -258,11 +258,11 @@
  */
 
 #define ALT_MODULE_CLASS_burst_master_4_0 burst_master_4
-#define BURST_MASTER_4_0_BASE 0x200c0
-#define BURST_MASTER_4_0_IRQ -1
-#define BURST_MASTER_4_0_IRQ_INTERRUPT_CONTROLLER_ID -1
+#define BURST_MASTER_4_0_BASE 0x20400
+#define BURST_MASTER_4_0_IRQ 4
+#define BURST_MASTER_4_0_IRQ_INTERRUPT_CONTROLLER_ID 0
 #define BURST_MASTER_4_0_NAME "/dev/burst_master_4_0"
-#define BURST_MASTER_4_0_SPAN 32
+#define BURST_MASTER_4_0_SPAN 256
 #define BURST_MASTER_4_0_TYPE "burst_master_4"
 
 
@@ -277,20 +277,6 @@
 #define ALT_TIMESTAMP_CLK none
 
 
-/*
- * hdmi_sync_mm configuration
- *
- */
-
-#define ALT_MODULE_CLASS_hdmi_sync_mm altera_avalon_mm_bridge
-#define HDMI_SYNC_MM_BASE 0x20020
-#define HDMI_SYNC_MM_IRQ -1
-#define HDMI_SYNC_MM_IRQ_INTERRUPT_CONTROLLER_ID -1
-#define HDMI_SYNC_MM_NAME "/dev/hdmi_sync_mm"
-#define HDMI_SYNC_MM_SPAN 32
-#define HDMI_SYNC_MM_TYPE "altera_avalon_mm_bridge"
-
-
 /*
  * i2c_hdmi configuration
  *
@@ -421,4 +407,18 @@
 #define TIMER_0_TIMEOUT_PULSE_OUTPUT 0
 #define TIMER_0_TYPE "altera_avalon_timer"
 
+
+/*
+ * video_pipeline_0 configuration
+ *
+ */
+
+#define ALT_MODULE_CLASS_video_pipeline_0 video_pipeline
+#define VIDEO_PIPELINE_0_BASE 0x20020
+#define VIDEO_PIPELINE_0_IRQ -1
+#define VIDEO_PIPELINE_0_IRQ_INTERRUPT_CONTROLLER_ID -1
+#define VIDEO_PIPELINE_0_NAME "/dev/video_pipeline_0"
+#define VIDEO_PIPELINE_0_SPAN 32
+#define VIDEO_PIPELINE_0_TYPE "video_pipeline"
+
 #endif /* __SYSTEM_H_ */
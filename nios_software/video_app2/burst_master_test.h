@@ -13,8 +13,174 @@
 #define REG_RD_BURST (5 * 4)
 #define REG_WR_BURST (6 * 4)
 #define REG_COEFF (7 * 4)
+#define REG_SPLIT_CNT (8 * 4) // Burst Master 4 only: [15:0] RD, [31:16] WR
+#define REG_QOS (9 * 4)       // [15:0] Read Words/us (0 = Off), [16] Urgent En
+#define REG_QOS_STALL (10 * 4) // dma_clk cycles held back by QoS
+
+#define REG_DESC_ADDR (11 * 4) // First descriptor (64-byte aligned)
+#define REG_DESC_CNT (12 * 4)  // Descriptors completed in the last chain
+
+#define REG_HEIGHT (13 * 4)     // 2D lines (0/1 = linear), LEN = line bytes
+#define REG_SRC_STRIDE (14 * 4) // Bytes between source lines
+#define REG_DST_STRIDE (15 * 4) // Bytes between destination lines
+
+#define REG_FILL (16 * 4)             // Write-only fill mode (register mode)
+#define REG_FILL_PAT(n) ((17 + (n)) * 4) // n = 0..7
+
+#define FILL_OFF 0      // Normal copy
+#define FILL_CONST 1    // Every word = PAT0
+#define FILL_PATTERN 2  // PAT0..PAT[n-1] repeated every word
+#define FILL_BARS 3     // PAT0..PAT[n-1], one entry per bar_words
+#define FILL_GRADIENT 4 // PAT0 + x * PAT1
+#define FILL_CFG(mode, n, bar_words)                                           \
+  (((bar_words) << 16) | ((((n)-1) & 7) << 4) | (mode))
+
+#define REG_PIX_OP (25 * 4)    // Pixel ALU operation (XRGB, per channel)
+#define REG_PIX_PARAM (26 * 4) // Operation parameter
+
+#define PIX_OP_COEFF 0     // Word * COEFF / 400 (benchmark)
+#define PIX_OP_PASS 1      // Plain copy
+#define PIX_OP_BRIGHT 2    // PARAM [8:0] gain (128 = 1.0), [24:16] signed offset
+#define PIX_OP_GRAY 3      // Y = (77R + 150G + 29B) >> 8
+#define PIX_OP_SWIZZLE 4   // Out byte n = in byte PARAM[2n+1:2n]
+#define PIX_OP_THRESHOLD 5 // Y >= PARAM[7:0] ? white : black
+#define PIX_OP_INVERT 6    // 255 - c
+#define PIX_OP_ADD_SAT 7   // min(c + PARAM channel, 255)
+// Dual-source ops (>= 8): A = SRC, B = SRC_B
+#define PIX_OP_BLEND 8     // (A * alpha + B * (256 - alpha)) >> 8, PARAM = alpha
+#define PIX_OP_ABSDIFF 9   // |A - B|
+#define PIX_OP_MIN 10
+#define PIX_OP_MAX 11
+#define PIX_OP_ADD2_SAT 12 // min(A + B, 255)
+#define REG_SRC_B (27 * 4) // Second source for dual-source ops
+
+// Format conversion: LEN stays in XRGB bytes (pixels * 4)
+#define REG_FMT (28 * 4) // [1:0] source format, [5:4] destination format
+#define FMT_XRGB32 0     // B G R X
+#define FMT_RGB888 1     // B G R, packed
+#define FMT_RGB565 2
+#define FMT_YUYV 3       // Y0 U Y1 V, BT.601 full range
+#define FMT_CFG(src, dst) (((dst) << 4) | (src))
+#define PIX_BRIGHT(gain, offset) ((((offset)&0x1FF) << 16) | ((gain)&0x1FF))
+#define PIX_SWZ_IDENTITY 0xE4
+#define PIX_SWZ_RB_SWAP 0xC6 // XRGB <-> XBGR
+
+// Bilinear resize (register mode): source = LEN/4 x HEIGHT pixels
+#define REG_SCALE_SIZE (29 * 4)   // [15:0] dst width (px, 0 = off), [31:16] dst height
+#define REG_SCALE_STEP_X (30 * 4) // 16.16 source pixels per destination pixel
+#define REG_SCALE_STEP_Y (31 * 4)
+#define SCALE_SIZE(w, h) (((h) << 16) | (w))
+#define SCALE_STEP(src, dst) ((unsigned int)(((unsigned long long)(src) << 16) / (dst)))
+
+// Tiled rotate/flip (register mode, XRGB32): source = LEN/4 x HEIGHT pixels
+#define REG_ROTATE (32 * 4)
+#define ROT_OFF 0
+#define ROT_90 1        // Clockwise; destination is HEIGHT x LEN/4
+#define ROT_180 2
+#define ROT_270 3
+#define ROT_FLIP_H 4    // Mirror left/right
+#define ROT_FLIP_V 5    // Mirror top/bottom
+#define ROT_TRANSPOSE 6 // Destination is HEIGHT x LEN/4
+
+// Memory BIST (register mode): WRITE fills DST, VERIFY reads SRC, LEN bytes
+#define REG_BIST (33 * 4)      // [1:0] mode, [5:4] pattern
+#define REG_BIST_SEED (34 * 4)
+#define REG_BIST_ERR_CNT (35 * 4)  // Mismatching words in the last verify
+#define REG_BIST_ERR_ADDR (36 * 4) // First mismatch: byte address
+#define REG_BIST_ERR_DATA (37 * 4) //                 data read
+#define REG_BIST_ERR_EXP (38 * 4)  //                 data expected
+#define BIST_OFF 0
+#define BIST_WRITE 1
+#define BIST_VERIFY 2
+#define BIST_PAT_ADDR 0 // addr ^ SEED
+#define BIST_PAT_WALK 1 // (1 << addr[6:2]) ^ SEED
+#define BIST_PAT_LFSR 2 // Galois LFSR from SEED
+#define BIST_PAT_ALT 3  // addr[2] ? ~SEED : SEED
+#define BIST_CFG(mode, pat) (((pat) << 4) | (mode))
+
+#define BIST_BASE 0x20000000  // Reserved region (Linux mem=512M)
+#define BIST_BYTES 0x20000000
+
+// Completion interrupt: IRQ = Done && IRQ_EN, dropped by the STATUS W1C
+#define REG_IRQ_EN (39 * 4)    // Burst Master 4
+#define REG_IRQ_EN_BM0 (7 * 4) // burst_master_0 (offset 7 is COEFF on BM4)
+#define IRQ_EN_DONE (1 << 0)
+#define IRQ_PENDING (1u << 31) // Read-only in IRQ_EN
+
+// Performance counters (read-only, dma_clk cycles, last completed transfer)
+#define REG_PERF_BUSY (40 * 4)      // Start to Done
+#define REG_PERF_RD_STALL (41 * 4)  // rm_read held by waitrequest
+#define REG_PERF_WR_STALL (42 * 4)  // wm_write held by waitrequest
+#define REG_PERF_WR_WAIT (43 * 4)   // Write master waiting for data (or QoS)
+#define REG_PERF_RD_BURSTS (44 * 4)
+#define REG_PERF_WR_BURSTS (45 * 4)
+#define REG_PERF_FIFO_PEAK (46 * 4) // [15:0] fifo_in, [31:16] fifo_out (words)
+#define REG_CUT_THROUGH (47 * 4)    // [0] Write cut-through (1:1 jobs)
+
+// Command queue: each push is a descriptor chain address, completions go to a
+// DDR ring of 16-byte entries (HEAD advances after the entry is written)
+#define REG_CQ_PUSH (48 * 4)      // Write-only
+#define REG_CQ_STATUS (49 * 4)    // [4:0] level, [8] full, [16] overflow (W1C)
+#define REG_CQ_RING (50 * 4)      // Ring base (physical, 16-byte aligned)
+#define REG_CQ_RING_SIZE (51 * 4) // Entries, power of 2 (0 = ring off)
+#define REG_CQ_HEAD (52 * 4)      // Entries written (read-only, free-running)
+#define REG_CQ_TAIL (53 * 4)      // Entries consumed by software
+#define CQ_DEPTH 16
+#define CQ_STATUS_FULL (1 << 8)
+#define CQ_STATUS_OVF (1 << 16)
+
+#define QOS_URGENT_EN (1 << 16)
+#define CTRL_START (1 << 0)
+#define CTRL_DESC_START (1 << 1)
+
+// Burst Master 4 descriptor (lives in DDR, 64 bytes)
+typedef struct {
+  unsigned int next;   // Next descriptor (physical), 0 = end of chain
+  unsigned int status; // Written back: [31] Done, [30:0] bytes moved
+  unsigned int src;
+  unsigned int dst;
+  unsigned int len;    // Bytes (line bytes in 2D)
+  unsigned int burst;  // [8:0] RD_BURST, [24:16] WR_BURST
+  unsigned int coeff;
+  unsigned int flags;  // [0] LAST
+  unsigned int height; // 2D lines (0/1 = linear)
+  unsigned int src_stride;
+  unsigned int dst_stride;
+  unsigned int pix_op; // PIX_OP_*, 0 = COEFF
+  unsigned int pix_param;
+  unsigned int src_b; // Second source (dual-source ops)
+  unsigned int fmt;   // FMT_CFG(src, dst)
+  unsigned int reserved;
+} bm4_desc_t;
+
+#define DESC_STATUS_DONE (1u << 31)
+#define DESC_FLAG_LAST (1 << 0)
+#define DESC_BURST(rd, wr) (((wr) << 16) | (rd))
+
+// Command queue completion entry (16 bytes)
+typedef struct {
+  unsigned int desc;    // Descriptor address that was pushed
+  unsigned int status;  // [31] Done, [30:0] bytes moved by the whole chain
+  unsigned int t_start; // dma_clk timestamps
+  unsigned int t_end;
+} bm4_cpl_t;
+
+#define DESC_TEST_SEGMENTS 16
+#define DESC_TEST_SEG_WORDS (16 * 1024) // 64KB per segment
+
+// Registers an ISR and enables the Done IRQ; returns -1 if the engine has no IRQ
+int bm_irq_init(unsigned int csr_base, unsigned int irq_en_reg, int ic_id,
+                int irq);
+// Waits for Done (ISR flag if registered, else STATUS polling) and clears it
+void bm_wait_done(unsigned int csr_base);
+
+// Prints the Burst Master 4 performance counters of the last transfer
+void bm4_print_perf(unsigned int csr_base);
 
 void run_ocm_to_ddr_test(unsigned int csr_base, unsigned int ddr_base);
 void run_ddr_to_ddr_test(unsigned int csr_base, unsigned int ddr_base);
+void run_desc_chain_test(unsigned int csr_base, unsigned int ddr_base);
+void run_bist_test(unsigned int csr_base);
+void run_cmd_queue_test(unsigned int csr_base, unsigned int ddr_base);
 
 #endif /* BURST_MASTER_TEST_H_ */
@@ -13,7 +13,10 @@ void print_menu() {
   printf(" [4] Generate 720p Color Bar Pattern in DDR3\n");
   printf(" [5] Change RTL Test Pattern (Red, Green, Blue, etc.)\n");
   printf(" [6] Gamma Correction Settings (Table, Toggle, Standard)\n");
+  printf(" [7] Descriptor Chain DMA Test (16 x 64KB)\n");
   printf(" [8] DMA & Video Source Debug Submenu\n");
+  printf(" [9] Memory BIST of the Reserved 512MB (Burst Master 4)\n");
+  printf(" [A] Async Command Queue DMA Test (16 x 64KB)\n");
   printf(" [C] Load Custom Character Bitmap\n");
   printf(" [r] Reset RTL Pattern Generator\n");
   printf(" [q] Quit\n");
@@ -59,6 +62,42 @@ void run_interactive_menu() {
       printf("Error: BURST_MASTER_4_0 not found in system.h\n");
 #endif
       break;
+    case '7':
+#ifdef BURST_MASTER_4_0_BASE
+      IOWR_32DIRECT(ADDRESS_SPAN_EXTENDER_0_CNTL_BASE, 0, 0x20000000);
+      printf("[Switch] Window mapped to 0x20000000 for Benchmark\n");
+
+      run_desc_chain_test(BURST_MASTER_4_0_BASE | CACHE_BYPASS_MASK,
+                          0x20000000);
+
+      IOWR_32DIRECT(ADDRESS_SPAN_EXTENDER_0_CNTL_BASE, 0, 0x30000000);
+      printf("[Restore] Window mapped to 0x30000000 for Video\n");
+#else
+      printf("Error: BURST_MASTER_4_0 not found in system.h\n");
+#endif
+      break;
+    case '9':
+#ifdef BURST_MASTER_4_0_BASE
+      run_bist_test(BURST_MASTER_4_0_BASE | CACHE_BYPASS_MASK);
+#else
+      printf("Error: BURST_MASTER_4_0 not found in system.h\n");
+#endif
+      break;
+    case 'A':
+    case 'a':
+#ifdef BURST_MASTER_4_0_BASE
+      IOWR_32DIRECT(ADDRESS_SPAN_EXTENDER_0_CNTL_BASE, 0, 0x20000000);
+      printf("[Switch] Window mapped to 0x20000000 for Benchmark\n");
+
+      run_cmd_queue_test(BURST_MASTER_4_0_BASE | CACHE_BYPASS_MASK,
+                         0x20000000);
+
+      IOWR_32DIRECT(ADDRESS_SPAN_EXTENDER_0_CNTL_BASE, 0, 0x30000000);
+      printf("[Restore] Window mapped to 0x30000000 for Video\n");
+#else
+      printf("Error: BURST_MASTER_4_0 not found in system.h\n");
+#endif
+      break;
     case '3':
       hdmi_init();
       break;
@@ -135,6 +174,20 @@ int main() {
   }
 #endif
 
+  // DMA completion via IRQ (falls back to STATUS polling when not wired)
+#if defined(BURST_MASTER_0_IRQ) && BURST_MASTER_0_IRQ >= 0
+  if (bm_irq_init(BURST_MASTER_0_BASE | CACHE_BYPASS_MASK, REG_IRQ_EN_BM0,
+                  BURST_MASTER_0_IRQ_INTERRUPT_CONTROLLER_ID,
+                  BURST_MASTER_0_IRQ) == 0)
+    printf("burst_master_0: completion IRQ %d\n", BURST_MASTER_0_IRQ);
+#endif
+#if defined(BURST_MASTER_4_0_IRQ) && BURST_MASTER_4_0_IRQ >= 0
+  if (bm_irq_init(BURST_MASTER_4_0_BASE | CACHE_BYPASS_MASK, REG_IRQ_EN,
+                  BURST_MASTER_4_0_IRQ_INTERRUPT_CONTROLLER_ID,
+                  BURST_MASTER_4_0_IRQ) == 0)
+    printf("burst_master_4_0: completion IRQ %d\n", BURST_MASTER_4_0_IRQ);
+#endif
+
   run_interactive_menu();
   return 0;
 }
@@ -3,16 +3,6 @@ module soc_system (
 	button_pio_external_connection_export,
 	clk_clk,
 	dipsw_pio_external_connection_export,
-	hdmi_sync_master_waitrequest,
-	hdmi_sync_master_readdata,
-	hdmi_sync_master_readdatavalid,
-	hdmi_sync_master_burstcount,
-	hdmi_sync_master_writedata,
-	hdmi_sync_master_address,
-	hdmi_sync_master_write,
-	hdmi_sync_master_read,
-	hdmi_sync_master_byteenable,
-	hdmi_sync_master_debugaccess,
 	hps_0_f2h_cold_reset_req_reset_n,
 	hps_0_f2h_debug_reset_req_reset_n,
 	hps_0_f2h_stm_hw_events_stm_hwevents,
@@ -89,30 +79,15 @@ module soc_system (
 	memory_oct_rzqin,
 	pll_outclk_clk,
 	reset_reset_n,
-	video_dma_s_waitrequest,
-	video_dma_s_readdata,
-	video_dma_s_readdatavalid,
-	video_dma_s_burstcount,
-	video_dma_s_writedata,
-	video_dma_s_address,
-	video_dma_s_write,
-	video_dma_s_read,
-	video_dma_s_byteenable,
-	video_dma_s_debugaccess);	
+	video_hdmi_d,
+	video_hdmi_de,
+	video_hdmi_hs,
+	video_hdmi_vs,
+	video_hdmi_debug_leds);	
 
 	input	[1:0]	button_pio_external_connection_export;
 	input		clk_clk;
 	input	[3:0]	dipsw_pio_external_connection_export;
-	input		hdmi_sync_master_waitrequest;
-	input	[31:0]	hdmi_sync_master_readdata;
-	input		hdmi_sync_master_readdatavalid;
-	output	[0:0]	hdmi_sync_master_burstcount;
-	output	[31:0]	hdmi_sync_master_writedata;
-	output	[2:0]	hdmi_sync_master_address;
-	output		hdmi_sync_master_write;
-	output		hdmi_sync_master_read;
-	output	[3:0]	hdmi_sync_master_byteenable;
-	output		hdmi_sync_master_debugaccess;
 	input		hps_0_f2h_cold_reset_req_reset_n;
 	input		hps_0_f2h_debug_reset_req_reset_n;
 	input	[27:0]	hps_0_f2h_stm_hw_events_stm_hwevents;
@@ -189,14 +164,9 @@ module soc_system (
 	input		memory_oct_rzqin;
 	output		pll_outclk_clk;
 	input		reset_reset_n;
-	output		video_dma_s_waitrequest;
-	output	[31:0]	video_dma_s_readdata;
-	output		video_dma_s_readdatavalid;
-	input	[8:0]	video_dma_s_burstcount;
-	input	[31:0]	video_dma_s_writedata;
-	input	[31:0]	video_dma_s_address;
-	input		video_dma_s_write;
-	input		video_dma_s_read;
-	input	[3:0]	video_dma_s_byteenable;
-	input		video_dma_s_debugaccess;
+	output	[23:0]	video_hdmi_d;
+	output		video_hdmi_de;
+	output		video_hdmi_hs;
+	output		video_hdmi_vs;
+	output	[7:0]	video_hdmi_debug_leds;
 endmodule
@@ -2,16 +2,6 @@
 		.button_pio_external_connection_export (<connected-to-button_pio_external_connection_export>), // button_pio_external_connection.export
 		.clk_clk                               (<connected-to-clk_clk>),                               //                            clk.clk
 		.dipsw_pio_external_connection_export  (<connected-to-dipsw_pio_external_connection_export>),  //  dipsw_pio_external_connection.export
-		.hdmi_sync_master_waitrequest          (<connected-to-hdmi_sync_master_waitrequest>),          //               hdmi_sync_master.waitrequest
-		.hdmi_sync_master_readdata             (<connected-to-hdmi_sync_master_readdata>),             //                               .readdata
-		.hdmi_sync_master_readdatavalid        (<connected-to-hdmi_sync_master_readdatavalid>),        //                               .readdatavalid
-		.hdmi_sync_master_burstcount           (<connected-to-hdmi_sync_master_burstcount>),           //                               .burstcount
-		.hdmi_sync_master_writedata            (<connected-to-hdmi_sync_master_writedata>),            //                               .writedata
-		.hdmi_sync_master_address              (<connected-to-hdmi_sync_master_address>),              //                               .address
-		.hdmi_sync_master_write                (<connected-to-hdmi_sync_master_write>),                //                               .write
-		.hdmi_sync_master_read                 (<connected-to-hdmi_sync_master_read>),                 //                               .read
-		.hdmi_sync_master_byteenable           (<connected-to-hdmi_sync_master_byteenable>),           //                               .byteenable
-		.hdmi_sync_master_debugaccess          (<connected-to-hdmi_sync_master_debugaccess>),          //                               .debugaccess
 		.hps_0_f2h_cold_reset_req_reset_n      (<connected-to-hps_0_f2h_cold_reset_req_reset_n>),      //       hps_0_f2h_cold_reset_req.reset_n
 		.hps_0_f2h_debug_reset_req_reset_n     (<connected-to-hps_0_f2h_debug_reset_req_reset_n>),     //      hps_0_f2h_debug_reset_req.reset_n
 		.hps_0_f2h_stm_hw_events_stm_hwevents  (<connected-to-hps_0_f2h_stm_hw_events_stm_hwevents>),  //        hps_0_f2h_stm_hw_events.stm_hwevents
@@ -88,15 +78,10 @@
 		.memory_oct_rzqin                      (<connected-to-memory_oct_rzqin>),                      //                               .oct_rzqin
 		.pll_outclk_clk                        (<connected-to-pll_outclk_clk>),                        //                     pll_outclk.clk
 		.reset_reset_n                         (<connected-to-reset_reset_n>),                         //                          reset.reset_n
-		.video_dma_s_waitrequest               (<connected-to-video_dma_s_waitrequest>),               //                    video_dma_s.waitrequest
-		.video_dma_s_readdata                  (<connected-to-video_dma_s_readdata>),                  //                               .readdata
-		.video_dma_s_readdatavalid             (<connected-to-video_dma_s_readdatavalid>),             //                               .readdatavalid
-		.video_dma_s_burstcount                (<connected-to-video_dma_s_burstcount>),                //                               .burstcount
-		.video_dma_s_writedata                 (<connected-to-video_dma_s_writedata>),                 //                               .writedata
-		.video_dma_s_address                   (<connected-to-video_dma_s_address>),                   //                               .address
-		.video_dma_s_write                     (<connected-to-video_dma_s_write>),                     //                               .write
-		.video_dma_s_read                      (<connected-to-video_dma_s_read>),                      //                               .read
-		.video_dma_s_byteenable                (<connected-to-video_dma_s_byteenable>),                //                               .byteenable
-		.video_dma_s_debugaccess               (<connected-to-video_dma_s_debugaccess>)                //                               .debugaccess
+		.video_hdmi_d                          (<connected-to-video_hdmi_d>),                          //                     video_hdmi.d
+		.video_hdmi_de                         (<connected-to-video_hdmi_de>),                         //                               .de
+		.video_hdmi_hs                         (<connected-to-video_hdmi_hs>),                         //                               .hs
+		.video_hdmi_vs                         (<connected-to-video_hdmi_vs>),                         //                               .vs
+		.video_hdmi_debug_leds                 (<connected-to-video_hdmi_debug_leds>)                  //                               .debug_leds
 	);
 
@@ -3,16 +3,6 @@
 			button_pio_external_connection_export : in    std_logic_vector(1 downto 0)  := (others => 'X'); -- export
 			clk_clk                               : in    std_logic                     := 'X';             -- clk
 			dipsw_pio_external_connection_export  : in    std_logic_vector(3 downto 0)  := (others => 'X'); -- export
-			hdmi_sync_master_waitrequest          : in    std_logic                     := 'X';             -- waitrequest
-			hdmi_sync_master_readdata             : in    std_logic_vector(31 downto 0) := (others => 'X'); -- readdata
-			hdmi_sync_master_readdatavalid        : in    std_logic                     := 'X';             -- readdatavalid
-			hdmi_sync_master_burstcount           : out   std_logic_vector(0 downto 0);                     -- burstcount
-			hdmi_sync_master_writedata            : out   std_logic_vector(31 downto 0);                    -- writedata
-			hdmi_sync_master_address              : out   std_logic_vector(2 downto 0);                     -- address
-			hdmi_sync_master_write                : out   std_logic;                                        -- write
-			hdmi_sync_master_read                 : out   std_logic;                                        -- read
-			hdmi_sync_master_byteenable           : out   std_logic_vector(3 downto 0);                     -- byteenable
-			hdmi_sync_master_debugaccess          : out   std_logic;                                        -- debugaccess
 			hps_0_f2h_cold_reset_req_reset_n      : in    std_logic                     := 'X';             -- reset_n
 			hps_0_f2h_debug_reset_req_reset_n     : in    std_logic                     := 'X';             -- reset_n
 			hps_0_f2h_stm_hw_events_stm_hwevents  : in    std_logic_vector(27 downto 0) := (others => 'X'); -- stm_hwevents
@@ -89,16 +79,11 @@
 			memory_oct_rzqin                      : in    std_logic                     := 'X';             -- oct_rzqin
 			pll_outclk_clk                        : out   std_logic;                                        -- clk
 			reset_reset_n                         : in    std_logic                     := 'X';             -- reset_n
-			video_dma_s_waitrequest               : out   std_logic;                                        -- waitrequest
-			video_dma_s_readdata                  : out   std_logic_vector(31 downto 0);                    -- readdata
-			video_dma_s_readdatavalid             : out   std_logic;                                        -- readdatavalid
-			video_dma_s_burstcount                : in    std_logic_vector(8 downto 0)  := (others => 'X'); -- burstcount
-			video_dma_s_writedata                 : in    std_logic_vector(31 downto 0) := (others => 'X'); -- writedata
-			video_dma_s_address                   : in    std_logic_vector(31 downto 0) := (others => 'X'); -- address
-			video_dma_s_write                     : in    std_logic                     := 'X';             -- write
-			video_dma_s_read                      : in    std_logic                     := 'X';             -- read
-			video_dma_s_byteenable                : in    std_logic_vector(3 downto 0)  := (others => 'X'); -- byteenable
-			video_dma_s_debugaccess               : in    std_logic                     := 'X'              -- debugaccess
+			video_hdmi_d                          : out   std_logic_vector(23 downto 0);                    -- d
+			video_hdmi_de                         : out   std_logic;                                        -- de
+			video_hdmi_hs                         : out   std_logic;                                        -- hs
+			video_hdmi_vs                         : out   std_logic;                                        -- vs
+			video_hdmi_debug_leds                 : out   std_logic_vector(7 downto 0)                      -- debug_leds
 		);
 	end component soc_system;
 
@@ -107,16 +92,6 @@
 			button_pio_external_connection_export => CONNECTED_TO_button_pio_external_connection_export, -- button_pio_external_connection.export
 			clk_clk                               => CONNECTED_TO_clk_clk,                               --                            clk.clk
 			dipsw_pio_external_connection_export  => CONNECTED_TO_dipsw_pio_external_connection_export,  --  dipsw_pio_external_connection.export
-			hdmi_sync_master_waitrequest          => CONNECTED_TO_hdmi_sync_master_waitrequest,          --               hdmi_sync_master.waitrequest
-			hdmi_sync_master_readdata             => CONNECTED_TO_hdmi_sync_master_readdata,             --                               .readdata
-			hdmi_sync_master_readdatavalid        => CONNECTED_TO_hdmi_sync_master_readdatavalid,        --                               .readdatavalid
-			hdmi_sync_master_burstcount           => CONNECTED_TO_hdmi_sync_master_burstcount,           --                               .burstcount
-			hdmi_sync_master_writedata            => CONNECTED_TO_hdmi_sync_master_writedata,            --                               .writedata
-			hdmi_sync_master_address              => CONNECTED_TO_hdmi_sync_master_address,              --                               .address
-			hdmi_sync_master_write                => CONNECTED_TO_hdmi_sync_master_write,                --                               .write
-			hdmi_sync_master_read                 => CONNECTED_TO_hdmi_sync_master_read,                 --                               .read
-			hdmi_sync_master_byteenable           => CONNECTED_TO_hdmi_sync_master_byteenable,           --                               .byteenable
-			hdmi_sync_master_debugaccess          => CONNECTED_TO_hdmi_sync_master_debugaccess,          --                               .debugaccess
 			hps_0_f2h_cold_reset_req_reset_n      => CONNECTED_TO_hps_0_f2h_cold_reset_req_reset_n,      --       hps_0_f2h_cold_reset_req.reset_n
 			hps_0_f2h_debug_reset_req_reset_n     => CONNECTED_TO_hps_0_f2h_debug_reset_req_reset_n,     --      hps_0_f2h_debug_reset_req.reset_n
 			hps_0_f2h_stm_hw_events_stm_hwevents  => CONNECTED_TO_hps_0_f2h_stm_hw_events_stm_hwevents,  --        hps_0_f2h_stm_hw_events.stm_hwevents
@@ -193,15 +168,10 @@
 			memory_oct_rzqin                      => CONNECTED_TO_memory_oct_rzqin,                      --                               .oct_rzqin
 			pll_outclk_clk                        => CONNECTED_TO_pll_outclk_clk,                        --                     pll_outclk.clk
 			reset_reset_n                         => CONNECTED_TO_reset_reset_n,                         --                          reset.reset_n
-			video_dma_s_waitrequest               => CONNECTED_TO_video_dma_s_waitrequest,               --                    video_dma_s.waitrequest
-			video_dma_s_readdata                  => CONNECTED_TO_video_dma_s_readdata,                  --                               .readdata
-			video_dma_s_readdatavalid             => CONNECTED_TO_video_dma_s_readdatavalid,             --                               .readdatavalid
-			video_dma_s_burstcount                => CONNECTED_TO_video_dma_s_burstcount,                --                               .burstcount
-			video_dma_s_writedata                 => CONNECTED_TO_video_dma_s_writedata,                 --                               .writedata
-			video_dma_s_address                   => CONNECTED_TO_video_dma_s_address,                   --                               .address
-			video_dma_s_write                     => CONNECTED_TO_video_dma_s_write,                     --                               .write
-			video_dma_s_read                      => CONNECTED_TO_video_dma_s_read,                      --                               .read
-			video_dma_s_byteenable                => CONNECTED_TO_video_dma_s_byteenable,                --                               .byteenable
-			video_dma_s_debugaccess               => CONNECTED_TO_video_dma_s_debugaccess                --                               .debugaccess
+			video_hdmi_d                          => CONNECTED_TO_video_hdmi_d,                          --                     video_hdmi.d
+			video_hdmi_de                         => CONNECTED_TO_video_hdmi_de,                         --                               .de
+			video_hdmi_hs                         => CONNECTED_TO_video_hdmi_hs,                         --                               .hs
+			video_hdmi_vs                         => CONNECTED_TO_video_hdmi_vs,                         --                               .vs
+			video_hdmi_debug_leds                 => CONNECTED_TO_video_hdmi_debug_leds                  --                               .debug_leds
 		);
 
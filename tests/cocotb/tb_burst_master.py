@@ -0,0 +1,274 @@
+import cocotb
+from cocotb.clock import Clock
+from cocotb.triggers import RisingEdge, ReadOnly, Timer
+from cocotb.queue import Queue
+import random
+
+# CSR word offsets
+REG_CTRL, REG_STATUS, REG_SRC, REG_DST, REG_LEN = 0, 1, 2, 3, 4
+REG_RD_BURST, REG_WR_BURST, REG_IRQ_EN = 5, 6, 7
+
+CTRL_START = 1 << 0
+STATUS_ALIGN_ERR = 1 << 2
+GUARD = 0xA5A5A5A5
+
+
+class AvalonMemory:
+    """Word-addressed memory behind the read and write masters (dma_clk)"""
+
+    def __init__(self, dut):
+        self.dut = dut
+        self.mem = {}
+        self.reads = []      # (addr, burstcount) as issued
+        self.writes = []     # (addr, burstcount) as issued
+        self.beats = []      # (addr, byteenable) per accepted write beat
+        self.req_queue = Queue()
+        self.stall = 0.0     # waitrequest probability per cycle (both masters)
+
+    def read(self, addr):
+        return self.mem.get(addr, 0xDEADBEEF)
+
+    def fill(self, addr, words):
+        for i, w in enumerate(words):
+            self.mem[addr + i * 4] = w
+
+    def read_bytes(self, addr, n):
+        return bytes((self.read(a & ~3) >> (8 * (a & 3))) & 0xFF for a in range(addr, addr + n))
+
+    def start(self):
+        self.dut.rm_waitrequest.value = 0
+        self.dut.rm_readdatavalid.value = 0
+        self.dut.rm_readdata.value = 0
+        self.dut.wm_waitrequest.value = 0
+        cocotb.start_soon(self.command_monitor())
+        cocotb.start_soon(self.read_responder())
+        cocotb.start_soon(self.write_slave())
+        cocotb.start_soon(self.stall_driver())
+
+    async def stall_driver(self):
+        while True:
+            await RisingEdge(self.dut.dma_clk)
+            self.dut.rm_waitrequest.value = int(self.stall > 0 and random.random() < self.stall)
+            self.dut.wm_waitrequest.value = int(self.stall > 0 and random.random() < self.stall)
+
+    async def command_monitor(self):
+        while True:
+            await RisingEdge(self.dut.dma_clk)
+            if self.dut.rm_read.value == 1 and self.dut.rm_waitrequest.value == 0:
+                req = (int(self.dut.rm_address.value), int(self.dut.rm_burstcount.value))
+                self.reads.append(req)
+                self.req_queue.put_nowait(req)
+
+    async def read_responder(self):
+        while True:
+            addr, burst = await self.req_queue.get()
+            for _ in range(random.randint(2, 8)):
+                await RisingEdge(self.dut.dma_clk)
+                self.dut.rm_readdatavalid.value = 0
+            for i in range(burst):
+                await RisingEdge(self.dut.dma_clk)
+                self.dut.rm_readdatavalid.value = 1
+                self.dut.rm_readdata.value = self.read(addr + i * 4)
+            await RisingEdge(self.dut.dma_clk)
+            self.dut.rm_readdatavalid.value = 0
+
+    async def write_slave(self):
+        beat, base, count = 0, 0, 0
+        while True:
+            await RisingEdge(self.dut.dma_clk)
+            await ReadOnly()
+            if self.dut.wm_write.value == 1 and self.dut.wm_waitrequest.value == 0:
+                if beat == 0:
+                    base = int(self.dut.wm_address.value)
+                    count = int(self.dut.wm_burstcount.value)
+                    self.writes.append((base, count))
+                be = int(self.dut.wm_byteenable.value)
+                mask = sum(0xFF << (8 * b) for b in range(4) if (be >> b) & 1)
+                addr = base + beat * 4
+                self.beats.append((addr, be))
+                self.mem[addr] = (self.read(addr) & ~mask) | (int(self.dut.wm_writedata.value) & mask)
+                beat = 0 if beat == count - 1 else beat + 1
+
+
+async def csr_write(dut, reg, value):
+    dut.avs_address.value = reg
+    dut.avs_writedata.value = value
+    dut.avs_write.value = 1
+    await RisingEdge(dut.clk)
+    dut.avs_write.value = 0
+
+
+async def csr_read(dut, reg):
+    dut.avs_address.value = reg
+    dut.avs_read.value = 1
+    await ReadOnly()
+    value = int(dut.avs_readdata.value)
+    await RisingEdge(dut.clk)
+    dut.avs_read.value = 0
+    return value
+
+
+async def wait_done(dut, timeout_cycles=50000):
+    for _ in range(timeout_cycles):
+        if (await csr_read(dut, REG_STATUS)) & 1:
+            await csr_write(dut, REG_STATUS, 1)
+            return
+    raise TimeoutError("DMA did not finish")
+
+
+async def setup(dut):
+    cocotb.start_soon(Clock(dut.clk, 20, units="ns").start())      # 50MHz CSR
+    cocotb.start_soon(Clock(dut.dma_clk, 10, units="ns").start())  # 100MHz DMA
+    dut.reset_n.value = 0
+    dut.dma_reset_n.value = 0
+    dut.avs_write.value = 0
+    dut.avs_read.value = 0
+    dut.avs_address.value = 0
+    dut.avs_writedata.value = 0
+
+    mem = AvalonMemory(dut)
+    mem.start()
+
+    await Timer(100, units="ns")
+    dut.reset_n.value = 1
+    dut.dma_reset_n.value = 1
+    await RisingEdge(dut.clk)
+    return mem
+
+
+async def check_copy(dut, mem, src, dst, length, rd_burst, wr_burst):
+    """Copies length bytes and checks data, guard words, bursts and byteenables"""
+    tag = f"SRC {src:#x} DST {dst:#x} LEN {length} bursts {rd_burst}/{wr_burst}"
+    head = dst & 3
+    words = (head + length + 3) // 4
+    first = dst & ~3
+
+    # Guard words on both sides of DST, and in the unused bytes of the end words
+    mem.fill(first - 16, [GUARD] * (words + 8))
+    mem.reads.clear()
+    mem.writes.clear()
+    mem.beats.clear()
+
+    await csr_write(dut, REG_SRC, src)
+    await csr_write(dut, REG_DST, dst)
+    await csr_write(dut, REG_LEN, length)
+    await csr_write(dut, REG_CTRL, CTRL_START)
+    await wait_done(dut)
+
+    assert mem.read_bytes(dst, length) == mem.read_bytes(src, length), f"{tag}: data mismatch"
+    assert mem.read_bytes(first - 16, 16 + head) == bytes([0xA5] * (16 + head)), f"{tag}: wrote before DST"
+    end = dst + length
+    assert mem.read_bytes(end, first + words * 4 + 16 - end) == bytes([0xA5] * (first + words * 4 + 16 - end)), \
+        f"{tag}: wrote past DST + LEN"
+
+    # Whole words from the aligned addresses; only the last burst is short
+    assert mem.reads[0][0] == src & ~3, f"{tag}: first read at {mem.reads[0][0]:#x}"
+    assert sum(c for _, c in mem.reads) == words, f"{tag}: read {mem.reads}"
+    assert all(c == rd_burst for _, c in mem.reads[:-1]), f"{tag}: short body read burst {mem.reads}"
+    assert mem.reads[-1][1] == (words - 1) % rd_burst + 1, f"{tag}: last read burst {mem.reads[-1]}"
+    assert mem.writes[0][0] == first, f"{tag}: first write at {mem.writes[0][0]:#x}"
+    assert sum(c for _, c in mem.writes) == words, f"{tag}: wrote {mem.writes}"
+    assert all(c == wr_burst for _, c in mem.writes[:-1]), f"{tag}: short body write burst {mem.writes}"
+    assert mem.writes[-1][1] == (words - 1) % wr_burst + 1, f"{tag}: last write burst {mem.writes[-1]}"
+
+    # Head/tail byteenables, full words in between
+    tail = (head + length) & 3
+    be_head = (0xF << head) & 0xF
+    be_tail = 0xF >> (4 - tail) if tail else 0xF
+    exp = [0xF] * words
+    exp[0] &= be_head
+    exp[-1] &= be_tail
+    got = [be for _, be in mem.beats]
+    assert [a for a, _ in mem.beats] == [first + i * 4 for i in range(words)], f"{tag}: write beat addresses"
+    assert got == exp, f"{tag}: byteenable {[hex(b) for b in got]}, expected {[hex(b) for b in exp]}"
+
+
+@cocotb.test()
+async def test_aligned_copy(dut):
+    """Word-aligned copies: full-burst body, short final burst, all byteenables set"""
+    mem = await setup(dut)
+    src, dst = 0x10000, 0x20000
+    mem.fill(src, [random.getrandbits(32) for _ in range(600)])
+
+    await csr_write(dut, REG_RD_BURST, 16)
+    await csr_write(dut, REG_WR_BURST, 16)
+    for length in (4, 64, 68, 1000, 2048):
+        await check_copy(dut, mem, src, dst, length, 16, 16)
+
+
+@cocotb.test()
+async def test_byte_exact(dut):
+    """Head offsets 1-3 x tail lengths 1-3, single word up to several bursts"""
+    mem = await setup(dut)
+    src_base, dst_base = 0x10000, 0x20000
+    mem.fill(src_base, [random.getrandbits(32) for _ in range(600)])
+
+    for rd_burst, wr_burst in ((16, 16), (16, 5)):
+        await csr_write(dut, REG_RD_BURST, rd_burst)
+        await csr_write(dut, REG_WR_BURST, wr_burst)
+        for off in range(4):
+            for length in (1, 2, 3, 5, 6, 7, 61, 62, 63, 65, 66, 67, 1001):
+                await check_copy(dut, mem, src_base + off, dst_base + off, length, rd_burst, wr_burst)
+
+
+@cocotb.test()
+async def test_byte_exact_waitrequest(dut):
+    """Byteenables and the short final burst hold up under random waitrequest"""
+    mem = await setup(dut)
+    src_base, dst_base = 0x10000, 0x20000
+    mem.fill(src_base, [random.getrandbits(32) for _ in range(600)])
+    mem.stall = 0.3
+
+    await csr_write(dut, REG_RD_BURST, 16)
+    await csr_write(dut, REG_WR_BURST, 16)
+    for off, length in ((1, 3), (2, 1), (3, 2), (1, 62), (3, 1001), (2, 1023)):
+        await check_copy(dut, mem, src_base + off, dst_base + off, length, 16, 16)
+
+
+@cocotb.test()
+async def test_misaligned_rejected(dut):
+    """SRC[1:0] != DST[1:0] is refused: Done with Align Error, no bus traffic"""
+    mem = await setup(dut)
+    src, dst = 0x10000, 0x20000
+    mem.fill(src, [random.getrandbits(32) for _ in range(260)])
+    mem.fill(dst, [GUARD] * 260)
+
+    await csr_write(dut, REG_SRC, src + 1)
+    await csr_write(dut, REG_DST, dst + 2)
+    await csr_write(dut, REG_LEN, 1001)
+    await csr_write(dut, REG_CTRL, CTRL_START)
+    for _ in range(200):
+        await RisingEdge(dut.clk)
+    status = await csr_read(dut, REG_STATUS)
+    assert status & 1 and status & STATUS_ALIGN_ERR, f"STATUS {status:#x}: expected Done + Align Error"
+    assert not status & 2, "Busy after a refused Start"
+    assert not mem.reads and not mem.beats, "Refused copy touched the bus"
+    assert all(mem.read(dst + i * 4) == GUARD for i in range(260)), "Refused copy wrote DST"
+    await csr_write(dut, REG_STATUS, 1)
+
+    # The next matched-offset Start clears the error
+    await check_copy(dut, mem, src + 2, dst + 2, 1001, 16, 16)
+    assert not (await csr_read(dut, REG_STATUS)) & STATUS_ALIGN_ERR, "Align Error not cleared by Start"
+
+
+@cocotb.test()
+async def test_irq(dut):
+    """IRQ follows Done when enabled and drops on the Done W1C"""
+    mem = await setup(dut)
+    mem.fill(0x10000, list(range(32)))
+    await csr_write(dut, REG_SRC, 0x10000)
+    await csr_write(dut, REG_DST, 0x20000)
+    await csr_write(dut, REG_LEN, 128)
+    await csr_write(dut, REG_IRQ_EN, 1)
+    await csr_write(dut, REG_CTRL, CTRL_START)
+
+    for _ in range(10000):
+        await RisingEdge(dut.clk)
+        if dut.irq.value == 1:
+            break
+    else:
+        raise TimeoutError("No IRQ")
+    assert (await csr_read(dut, REG_IRQ_EN)) >> 31 == 1, "IRQ pending bit not set"
+    await csr_write(dut, REG_STATUS, 1)
+    await RisingEdge(dut.clk)
+    assert dut.irq.value == 0, "IRQ still high after clearing Done"
@@ -26,7 +26,7 @@ class AvalonMemory:
         cocotb.start_soon(self.response_driver())
         
         while True:
-            await RisingEdge(self.dut.clk_50) 
+            await RisingEdge(self.dut.clk_dma) 
             try:
                 read_req = int(self.dut.m_read.value)
                 wait_req = int(self.dut.m_waitrequest.value)
@@ -47,17 +47,17 @@ class AvalonMemory:
             addr, burst = await self.req_queue.get()
             latency = random.randint(2, 10)
             for _ in range(latency):
-                await RisingEdge(self.dut.clk_50)
+                await RisingEdge(self.dut.clk_dma)
                 self.dut.m_readdatavalid.value = 0
             
             for i in range(burst):
-                await RisingEdge(self.dut.clk_50)
+                await RisingEdge(self.dut.clk_dma)
                 self.dut.m_readdatavalid.value = 1
                 addr_cal = addr + (i * 4)
                 data = self.mem.get(addr_cal, 0x000000)
                 self.dut.m_readdata.value = data
             
-            await RisingEdge(self.dut.clk_50)
+            await RisingEdge(self.dut.clk_dma)
             self.dut.m_readdatavalid.value = 0
 
 async def configure_pipeline(dut):
@@ -89,6 +89,7 @@ async def test_full_integration(dut):
     Verify DMA reads -> FIFO -> HDMI Output (960x540 qHD)
     """
     cocotb.start_soon(Clock(dut.clk_50, 20, units="ns").start()) # 50 MHz
+    cocotb.start_soon(Clock(dut.clk_dma, 10, units="ns").start()) # 100 MHz (DMA)
     cocotb.start_soon(Clock(dut.clk_hdmi, 26.43, units="ns").start()) # ~37.83 MHz
     
     debug_log_file = os.path.join(os.path.dirname(__file__), "debug_timing.log")
@@ -135,7 +136,7 @@ async def test_full_integration(dut):
     for _ in range(1000):
         await RisingEdge(dut.clk_50)
         try:
-            if int(dut.u_simple_fifo.wrusedw.value) > 32:
+            if int(dut.g_avalon.u_simple_fifo.wrusedw.value) > 32:
                 break
         except: pass
         
@@ -205,7 +206,7 @@ async def test_full_integration(dut):
             px_in_f = pixel_count % frame_size
             if px_in_f >= 950 and px_in_f <= 970:
                  with open(debug_log_file, "a") as f:
-                     f.write(f"[DEBUG] Fx {pixel_count // frame_size} Px {px_in_f}: {data:06X} (FIFO={int(dut.u_simple_fifo.wrusedw.value)})\n")
+                     f.write(f"[DEBUG] Fx {pixel_count // frame_size} Px {px_in_f}: {data:06X} (FIFO={int(dut.g_avalon.u_simple_fifo.wrusedw.value)})\n")
                      
             pixel_count += 1
             if pixel_count >= target_pixels:
@@ -13,6 +13,7 @@ async def test_pipeline_dma_control(dut):
     """Test DMA Start/Busy/Done/Stop through registers"""
     
     cocotb.start_soon(Clock(dut.clk_50, 20, unit="ns").start())
+    cocotb.start_soon(Clock(dut.clk_dma, 10, unit="ns").start())
     cocotb.start_soon(Clock(dut.clk_hdmi, 13468, unit="ps").start())
     
     await reset_pipeline(dut, 100)
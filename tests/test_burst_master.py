@@ -0,0 +1,27 @@
+import os
+import sys
+from cocotb_test.simulator import run
+
+def test_burst_master():
+    tests_dir = os.path.dirname(os.path.abspath(__file__))
+    proj_dir = os.path.dirname(tests_dir)
+    rtl_dir = os.path.join(proj_dir, "RTL")
+    
+    run(
+        verilog_sources=[
+            os.path.join(rtl_dir, "simple_fifo.v"),
+            os.path.join(rtl_dir, "burst_master.v")
+        ],
+        toplevel="burst_master",
+        module="tb_burst_master",
+        # Small bursts keep the simulation short
+        parameters={"BURST_COUNT": 16, "FIFO_DEPTH": 64},
+        python_search=[
+            os.path.join(tests_dir, "cocotb")
+        ],
+        sim="iverilog",
+        force_compile=True
+    )
+
+if __name__ == "__main__":
+    test_burst_master()
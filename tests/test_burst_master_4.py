@@ -0,0 +1,63 @@
+import os
+import sys
+from cocotb_test.simulator import run
+
+def test_burst_master_4():
+    tests_dir = os.path.dirname(os.path.abspath(__file__))
+    proj_dir = os.path.dirname(tests_dir)
+    rtl_dir = os.path.join(proj_dir, "RTL")
+    
+    run(
+        verilog_sources=[
+            os.path.join(rtl_dir, "simple_fifo.v"),
+            os.path.join(rtl_dir, "simple_dcfifo.v"),
+            os.path.join(rtl_dir, "pixel_unpack.v"),
+            os.path.join(rtl_dir, "pixel_pack.v"),
+            os.path.join(rtl_dir, "pixel_scaler.v"),
+            os.path.join(rtl_dir, "pixel_tile.v"),
+            os.path.join(rtl_dir, "burst_master_4.v")
+        ],
+        toplevel="burst_master_4",
+        module="tb_burst_master_4",
+        # Small bursts keep the simulation short
+        parameters={"BURST_COUNT": 16, "FIFO_DEPTH": 64},
+        extra_env={"FIFO_DEPTH": "64"},
+        python_search=[
+            os.path.join(tests_dir, "cocotb")
+        ],
+        sim="iverilog",
+        force_compile=True
+    )
+
+def test_burst_master_4_cut_through():
+    tests_dir = os.path.dirname(os.path.abspath(__file__))
+    proj_dir = os.path.dirname(tests_dir)
+    rtl_dir = os.path.join(proj_dir, "RTL")
+
+    # Full 256-word bursts need a 512-word FIFO (a read burst must fit twice)
+    run(
+        verilog_sources=[
+            os.path.join(rtl_dir, "simple_fifo.v"),
+            os.path.join(rtl_dir, "simple_dcfifo.v"),
+            os.path.join(rtl_dir, "pixel_unpack.v"),
+            os.path.join(rtl_dir, "pixel_pack.v"),
+            os.path.join(rtl_dir, "pixel_scaler.v"),
+            os.path.join(rtl_dir, "pixel_tile.v"),
+            os.path.join(rtl_dir, "burst_master_4.v")
+        ],
+        toplevel="burst_master_4",
+        module="tb_burst_master_4",
+        testcase="test_cut_through_throughput",
+        parameters={"BURST_COUNT": 256, "FIFO_DEPTH": 512},
+        extra_env={"FIFO_DEPTH": "512"},
+        python_search=[
+            os.path.join(tests_dir, "cocotb")
+        ],
+        sim="iverilog",
+        sim_build=os.path.join(tests_dir, "sim_build", "burst_master_4_fifo512"),
+        force_compile=True
+    )
+
+if __name__ == "__main__":
+    test_burst_master_4()
+    test_burst_master_4_cut_through()
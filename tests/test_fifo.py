@@ -20,5 +20,67 @@ def test_fifo():
         force_compile=True
     )
 
+def test_fifo_show_ahead():
+    tests_dir = os.path.dirname(os.path.abspath(__file__))
+    proj_dir = os.path.dirname(tests_dir)
+    rtl_dir = os.path.join(proj_dir, "RTL")
+
+    run(
+        verilog_sources=[
+            os.path.join(rtl_dir, "simple_dcfifo.v")
+        ],
+        toplevel="simple_dcfifo",
+        module="tb_fifo_modes",
+        testcase="test_show_ahead,test_show_ahead_streaming",
+        parameters={"SHOW_AHEAD": 1},
+        python_search=[
+            os.path.join(tests_dir, "cocotb")
+        ],
+        sim="iverilog",
+        sim_build=os.path.join(tests_dir, "sim_build", "simple_dcfifo_fwft"),
+        force_compile=True
+    )
+
+def test_fifo_asymmetric():
+    tests_dir = os.path.dirname(os.path.abspath(__file__))
+    proj_dir = os.path.dirname(tests_dir)
+    rtl_dir = os.path.join(proj_dir, "RTL")
+
+    # 64-bit write -> 32-bit read (normal mode)
+    run(
+        verilog_sources=[
+            os.path.join(rtl_dir, "simple_dcfifo.v")
+        ],
+        toplevel="simple_dcfifo",
+        module="tb_fifo_modes",
+        testcase="test_asymmetric_width",
+        parameters={"DATA_WIDTH": 64, "RD_DATA_WIDTH": 32},
+        python_search=[
+            os.path.join(tests_dir, "cocotb")
+        ],
+        sim="iverilog",
+        sim_build=os.path.join(tests_dir, "sim_build", "simple_dcfifo_64to32"),
+        force_compile=True
+    )
+
+    # 128-bit write -> 32-bit read with show-ahead
+    run(
+        verilog_sources=[
+            os.path.join(rtl_dir, "simple_dcfifo.v")
+        ],
+        toplevel="simple_dcfifo",
+        module="tb_fifo_modes",
+        testcase="test_show_ahead,test_show_ahead_streaming",
+        parameters={"DATA_WIDTH": 128, "RD_DATA_WIDTH": 32, "SHOW_AHEAD": 1},
+        python_search=[
+            os.path.join(tests_dir, "cocotb")
+        ],
+        sim="iverilog",
+        sim_build=os.path.join(tests_dir, "sim_build", "simple_dcfifo_128to32"),
+        force_compile=True
+    )
+
 if __name__ == "__main__":
     test_fifo()
+    test_fifo_show_ahead()
+    test_fifo_asymmetric()
@@ -0,0 +1,24 @@
+import os
+import sys
+from cocotb_test.simulator import run
+
+def test_video_dma_axi_master():
+    tests_dir = os.path.dirname(os.path.abspath(__file__))
+    proj_dir = os.path.dirname(tests_dir)
+    rtl_dir = os.path.join(proj_dir, "RTL")
+    
+    run(
+        verilog_sources=[os.path.join(rtl_dir, "video_dma_axi_master.v")],
+        toplevel="video_dma_axi_master",
+        module="tb_video_dma_axi_master",
+        # Small frame: 64x8 pixels = 256 beats of 64-bit
+        parameters={"H_RES": 64, "V_RES": 8},
+        python_search=[
+            os.path.join(tests_dir, "cocotb")
+        ],
+        sim="iverilog",
+        force_compile=True
+    )
+
+if __name__ == "__main__":
+    test_video_dma_axi_master()
@@ -11,6 +11,7 @@ def test_video_integration():
         verilog_sources=[
             os.path.join(rtl_dir, "simple_dcfifo.v"),
             os.path.join(rtl_dir, "video_dma_master.v"),
+            os.path.join(rtl_dir, "video_dma_axi_master.v"),
             os.path.join(rtl_dir, "hdmi_sync_gen.v"),
             os.path.join(rtl_dir, "video_pipeline.v")
         ],